@@ -0,0 +1,100 @@
+#include "animation-helper.h"
+
+#include "ns3/log.h"
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <limits>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("AnimationHelper");
+
+Animation::Animation (const std::string& fileName, const AnimationConfig& config)
+  : m_pipe (-1),
+    m_compressor (-1) {
+  std::string output = fileName + ".xml";
+  if (config.compress) {
+    m_pipe = StartCompressor (fileName + ".xml.gz");
+    if (m_pipe >= 0) {
+      output = "/dev/fd/" + std::to_string (m_pipe);
+    } else {
+      NS_LOG_ERROR("Não foi possível executar o gzip; a animação será gravada sem compressão.");
+    }
+  }
+
+  m_interface = std::make_unique<AnimationInterface> (output);
+  m_interface->SetStartTime (config.start);
+  m_interface->SetStopTime (config.stop);
+  if (!config.packets) {
+    m_interface->SkipPacketTracing ();
+  }
+  if (m_pipe >= 0) {
+    // Um pipe não pode ser dividido em vários arquivos
+    m_interface->SetMaxPktsPerTraceFile (std::numeric_limits<uint64_t>::max ());
+  }
+}
+
+Animation::~Animation () {
+  // O XML só termina quando o AnimationInterface fecha o arquivo; depois o gzip recebe o fim do pipe
+  m_interface.reset ();
+  if (m_pipe >= 0) {
+    close (m_pipe);
+    int status;
+    while (waitpid (m_compressor, &status, 0) < 0 && errno == EINTR) {
+    }
+  }
+}
+
+int Animation::StartCompressor (const std::string& fileName) {
+  int data[2];
+  int status[2];
+  if (pipe (data) < 0) {
+    return -1;
+  }
+  // O pipe de status é fechado pelo exec; se receber algo, o exec falhou
+  if (pipe2 (status, O_CLOEXEC) < 0) {
+    close (data[0]);
+    close (data[1]);
+    return -1;
+  }
+
+  pid_t pid = fork ();
+  if (pid == 0) {
+    close (data[1]);
+    close (status[0]);
+    int fd = open (fileName.c_str (), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0) {
+      dup2 (data[0], STDIN_FILENO);
+      dup2 (fd, STDOUT_FILENO);
+      close (fd);
+      execlp ("gzip", "gzip", "-c", static_cast<char*> (nullptr));
+    }
+    int error = errno;
+    ssize_t written = write (status[1], &error, sizeof (error));
+    (void) written;
+    _exit (127);
+  }
+
+  close (data[0]);
+  close (status[1]);
+  int error;
+  bool failed = pid < 0 || read (status[0], &error, sizeof (error)) > 0;
+  close (status[0]);
+  if (failed) {
+    if (pid > 0) {
+      waitpid (pid, nullptr, 0);
+      unlink (fileName.c_str ());
+    }
+    close (data[1]);
+    return -1;
+  }
+  fcntl (data[1], F_SETFD, FD_CLOEXEC);
+  m_compressor = pid;
+  return data[1];
+}
+
+} // namespace ns3
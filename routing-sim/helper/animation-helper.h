@@ -0,0 +1,66 @@
+#ifndef ANIMATION_HELPER_H
+#define ANIMATION_HELPER_H
+
+#include "ns3/animation-interface.h"
+#include "ns3/nstime.h"
+
+#include <sys/types.h>
+
+#include <memory>
+#include <string>
+
+namespace ns3 {
+
+/**
+ * Opções da animação do NetAnim.
+ */
+struct AnimationConfig {
+  Time start = Seconds (0);    //!< Início da janela gravada
+  Time stop = Time::Max ();    //!< Fim da janela gravada
+  bool packets = true;         //!< Grava os pacotes; false grava só os nós e enlaces
+  bool compress = false;       //!< Comprime o XML com o gzip enquanto a simulação roda
+};
+
+/**
+ * Animação do NetAnim de uma janela da simulação, gravada em <arquivo>.xml ou, comprimida, em
+ * <arquivo>.xml.gz.
+ *
+ * Na compressão, o AnimationInterface escreve em um pipe (/dev/fd/N) lido por um processo gzip,
+ * então o XML completo nunca chega ao disco. Se o gzip não puder ser executado, o XML é gravado
+ * sem compressão. O AnimationInterface é destruído antes do fim do gzip, no destrutor.
+ */
+class Animation {
+public:
+  Animation (const std::string& fileName, const AnimationConfig& config);
+  ~Animation ();
+
+  Animation (const Animation&) = delete;
+  Animation& operator= (const Animation&) = delete;
+
+  void UpdateNodeDescription (Ptr<Node> node, const std::string& description) {
+    m_interface->UpdateNodeDescription (node->GetId (), description);
+  }
+
+  void UpdateNodeSize (Ptr<Node> node, double width, double height) {
+    m_interface->UpdateNodeSize (node->GetId (), width, height);
+  }
+
+  void UpdateNodeColor (Ptr<Node> node, uint8_t r, uint8_t g, uint8_t b) {
+    m_interface->UpdateNodeColor (node->GetId (), r, g, b);
+  }
+
+private:
+  /**
+   * Inicia o gzip lendo de um pipe e gravando em fileName.
+   * @return Descritor de escrita do pipe, ou -1 se o gzip não pôde ser executado.
+   */
+  int StartCompressor (const std::string& fileName);
+
+  std::unique_ptr<AnimationInterface> m_interface;
+  int m_pipe;
+  pid_t m_compressor;
+};
+
+} // namespace ns3
+
+#endif /* ANIMATION_HELPER_H */
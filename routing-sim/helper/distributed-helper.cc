@@ -0,0 +1,78 @@
+#include "distributed-helper.h"
+
+#include "ns3/global-value.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+
+#ifdef NS3_MPI
+#include <mpi.h>
+#include "ns3/mpi-interface.h"
+#endif
+
+namespace ns3 {
+
+bool EnableDistributedSimulation (int* argc, char*** argv) {
+#ifdef NS3_MPI
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::DistributedSimulatorImpl"));
+  MpiInterface::Enable (argc, argv);
+  return true;
+#else
+  return false;
+#endif
+}
+
+void DisableDistributedSimulation () {
+#ifdef NS3_MPI
+  if (MpiInterface::IsEnabled ()) {
+    MpiInterface::Disable ();
+  }
+#endif
+}
+
+int FinishSimulation (int exitCode) {
+  Simulator::Destroy ();
+  DisableDistributedSimulation ();
+  return exitCode;
+}
+
+uint32_t GetSystemId () {
+#ifdef NS3_MPI
+  if (MpiInterface::IsEnabled ()) {
+    return MpiInterface::GetSystemId ();
+  }
+#endif
+  return 0;
+}
+
+uint32_t GetSystemCount () {
+#ifdef NS3_MPI
+  if (MpiInterface::IsEnabled ()) {
+    return MpiInterface::GetSize ();
+  }
+#endif
+  return 1;
+}
+
+double GetGlobalMaximum (double value) {
+#ifdef NS3_MPI
+  if (MpiInterface::IsEnabled ()) {
+    double result;
+    MPI_Allreduce (&value, &result, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    return result;
+  }
+#endif
+  return value;
+}
+
+double GetGlobalSum (double value) {
+#ifdef NS3_MPI
+  if (MpiInterface::IsEnabled ()) {
+    double result;
+    MPI_Allreduce (&value, &result, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    return result;
+  }
+#endif
+  return value;
+}
+
+} // namespace ns3
@@ -0,0 +1,53 @@
+#ifndef DISTRIBUTED_HELPER_H
+#define DISTRIBUTED_HELPER_H
+
+#include <cstdint>
+
+namespace ns3 {
+
+/**
+ * Seleciona o simulador distribuído do ns-3 (DistributedSimulatorImpl) e inicializa o MPI.
+ * Deve ser chamada depois do CommandLine::Parse e antes da criação dos nós; o cenário deve
+ * ser iniciado com o mpirun, um processo por partição da topologia.
+ *
+ * @return false se o ns-3 foi compilado sem MPI (./waf configure --enable-mpi).
+ */
+bool EnableDistributedSimulation (int* argc, char*** argv);
+
+/**
+ * Finaliza o MPI, depois do Simulator::Destroy.
+ */
+void DisableDistributedSimulation ();
+
+/**
+ * Destrói o simulador e finaliza o MPI. É o caminho de saída do cenário depois de
+ * EnableDistributedSimulation, inclusive em caso de erro, para que nenhum processo saia sem
+ * finalizar o MPI enquanto os demais o finalizam.
+ *
+ * @return exitCode, para ser devolvido pelo main.
+ */
+int FinishSimulation (int exitCode);
+
+/**
+ * @return Índice deste processo (0 sem simulação distribuída).
+ */
+uint32_t GetSystemId ();
+
+/**
+ * @return Número de processos (1 sem simulação distribuída).
+ */
+uint32_t GetSystemCount ();
+
+/**
+ * Maior valor entre todos os processos. Deve ser chamada por todos os processos, na mesma ordem.
+ */
+double GetGlobalMaximum (double value);
+
+/**
+ * Soma dos valores de todos os processos. Deve ser chamada por todos os processos, na mesma ordem.
+ */
+double GetGlobalSum (double value);
+
+} // namespace ns3
+
+#endif /* DISTRIBUTED_HELPER_H */
@@ -0,0 +1,85 @@
+#include "scenario-helper.h"
+
+#include "ns3/ipv4.h"
+#include "ns3/names.h"
+#include "ns3/node-list.h"
+#include "ns3/traffic-control-helper.h"
+#include "ns3/traffic-control-layer.h"
+
+namespace ns3 {
+
+Ptr<Node> CreateNode (const std::string& name, uint32_t systemId) {
+  Ptr<Node> node = CreateObject<Node> (systemId);
+  Names::Add (name, node);
+  return node;
+}
+
+void SetRipMetrics (RipHelper& ripHelper, const AdjacencyIndex& adjacency) {
+  for (uint32_t i = 0; i < adjacency.GetNLinks (); ++i) {
+    const auto& link = adjacency.GetLink (i);
+    if (link.cost != 1) {
+      ripHelper.SetInterfaceMetric (NodeList::GetNode (link.node1), link.interface1, link.cost);
+      ripHelper.SetInterfaceMetric (NodeList::GetNode (link.node2), link.interface2, link.cost);
+    }
+  }
+}
+
+bool SetRipMetric (RipHelper& ripHelper, const AdjacencyIndex& adjacency, Ptr<Node> node, Ptr<Node> neighbor,
+                   uint8_t metric) {
+  uint32_t interface = adjacency.GetInterface (node->GetId (), neighbor->GetId ());
+  if (interface == AdjacencyIndex::NOT_FOUND) {
+    return false;
+  }
+  ripHelper.SetInterfaceMetric (node, interface, metric);
+  return true;
+}
+
+Ipv4InterfaceContainer AssignSubnet (const NetDeviceContainer& devices, SubnetAllocator& subnets) {
+  uint32_t subnet = subnets.Allocate ();
+  NS_ASSERT_MSG (subnet != SubnetAllocator::NOT_AVAILABLE, "Bloco de endereços esgotado");
+  NS_ASSERT_MSG (devices.GetN () <= subnets.GetHostCount (), "Sub-rede pequena demais para o enlace");
+
+  Ipv4InterfaceContainer interfaces;
+  for (uint32_t i = 0; i < devices.GetN (); ++i) {
+    Ptr<NetDevice> device = devices.Get (i);
+    Ptr<Ipv4> ipv4 = device->GetNode ()->GetObject<Ipv4> ();
+    int32_t interface = ipv4->GetInterfaceForDevice (device);
+    if (interface == -1) {
+      interface = ipv4->AddInterface (device);
+    }
+    ipv4->AddAddress (interface, Ipv4InterfaceAddress (subnets.GetHostAddress (subnet, i), subnets.GetMask ()));
+    ipv4->SetMetric (interface, 1);
+    ipv4->SetUp (interface);
+    interfaces.Add (ipv4, interface);
+    // Como no Ipv4AddressHelper, só instala a fila padrão se ainda não há uma no dispositivo
+    Ptr<TrafficControlLayer> tc = device->GetNode ()->GetObject<TrafficControlLayer> ();
+    if (tc != nullptr && tc->GetRootQueueDiscOnDevice (device) == nullptr) {
+      TrafficControlHelper tcHelper = TrafficControlHelper::Default ();
+      tcHelper.Install (device);
+    }
+  }
+  return interfaces;
+}
+
+void SetLinkState (NetDeviceContainer devices, bool up) {
+  for (uint32_t i = 0; i < devices.GetN (); ++i) {
+    Ptr<NetDevice> device = devices.Get(i);
+    Ptr<Ipv4> ipv4 = device->GetNode()->GetObject<Ipv4>();
+    uint32_t interface = ipv4->GetInterfaceForDevice(device);
+    if (up) {
+      ipv4->SetUp(interface);
+    } else {
+      ipv4->SetDown(interface);
+    }
+  }
+}
+
+void TearDownLink (NetDeviceContainer devices) {
+  SetLinkState (devices, false);
+}
+
+void UpLink (NetDeviceContainer devices) {
+  SetLinkState (devices, true);
+}
+
+} // namespace ns3
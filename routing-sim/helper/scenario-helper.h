@@ -0,0 +1,72 @@
+#ifndef SCENARIO_HELPER_H
+#define SCENARIO_HELPER_H
+
+#include "ns3/adjacency-index.h"
+#include "ns3/ipv4-interface-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/node.h"
+#include "ns3/rip-helper.h"
+#include "ns3/subnet-allocator.h"
+
+#include <string>
+
+namespace ns3 {
+
+/**
+ * Cria um nó e o adiciona ao Names.
+ * @param systemId Processo que simula o nó na simulação distribuída.
+ */
+Ptr<Node> CreateNode (const std::string& name, uint32_t systemId = 0);
+
+/**
+ * Define no RipHelper a métrica das interfaces das duas pontas de cada enlace do índice com custo
+ * diferente de 1. Deve ser chamada antes do InternetStackHelper::Install, com um índice cujas
+ * interfaces sejam as que os nós terão depois da atribuição dos endereços.
+ */
+void SetRipMetrics (RipHelper& ripHelper, const AdjacencyIndex& adjacency);
+
+/**
+ * Define no RipHelper a métrica da interface de node para neighbor.
+ *
+ * @return false se os nós não são vizinhos no índice.
+ */
+bool SetRipMetric (RipHelper& ripHelper, const AdjacencyIndex& adjacency, Ptr<Node> node, Ptr<Node> neighbor,
+                   uint8_t metric);
+
+/**
+ * Aloca uma sub-rede para um enlace e atribui um endereço dela a cada dispositivo, na ordem do contêiner.
+ *
+ * Faz o mesmo que o Ipv4AddressHelper::Assign (interface, endereço, métrica 1, interface ativa e
+ * controle de tráfego padrão se o dispositivo ainda não tem uma fila raiz), mas com os endereços calculados
+ * pelo alocador.
+ *
+ * @param devices Dispositivos de rede conectados, com a pilha IPv4 já instalada nos nós.
+ * @param subnets Alocador de sub-redes, que deve ter uma sub-rede disponível com hosts suficientes.
+ */
+Ipv4InterfaceContainer AssignSubnet (const NetDeviceContainer& devices, SubnetAllocator& subnets);
+
+/**
+ * Habilita ou desabilita as interfaces IPv4 dos dispositivos de um enlace.
+ *
+ * @param devices Dispositivos de rede conectados.
+ * @param up true para habilitar o enlace.
+ */
+void SetLinkState (NetDeviceContainer devices, bool up);
+
+/**
+ * Desabilita um enlace entre dois nós de uma rede.
+ *
+ * @param devices Dispositivos de rede conectados.
+ */
+void TearDownLink (NetDeviceContainer devices);
+
+/**
+ * Habilita um enlace entre dois nós de uma rede.
+ *
+ * @param devices Dispositivos de rede conectados.
+ */
+void UpLink (NetDeviceContainer devices);
+
+} // namespace ns3
+
+#endif /* SCENARIO_HELPER_H */
@@ -0,0 +1,188 @@
+#include "topology-builder.h"
+#include "scenario-helper.h"
+
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4.h"
+#include "ns3/log.h"
+#include "ns3/olsr-helper.h"
+#include "ns3/rip-helper.h"
+#include "ns3/trace-helper.h"
+#include "ns3/traffic-control-helper.h"
+#include "ns3/traffic-control-layer.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TopologyBuilder");
+
+TopologyBuilder::TopologyBuilder (const TopologyDescription& topology)
+  : m_topology (topology),
+    m_systemId (0) {
+}
+
+void TopologyBuilder::SetPartition (const std::vector<uint32_t>& systemIds, uint32_t systemId) {
+  m_systemIds = systemIds;
+  m_systemId = systemId;
+}
+
+bool TopologyBuilder::Build (const std::string& routingProtocol, SubnetAllocator& subnets) {
+  const auto& nodes = m_topology.GetNodes ();
+  const auto& links = m_topology.GetLinks ();
+  if (subnets.GetAvailable () < links.size ()) {
+    NS_LOG_ERROR ("A topologia tem mais enlaces do que sub-redes disponíveis no bloco de endereços.");
+    return false;
+  }
+
+  for (uint32_t i = 0; i < nodes.size (); ++i) {
+    Ptr<Node> node = CreateNode (nodes[i].name, m_systemIds.empty () ? 0 : m_systemIds[i]);
+    m_nodes.Add (node);
+    if (nodes[i].router) {
+      m_routers.Add (node);
+      if (IsLocal (i)) {
+        m_localRouters.Add (node);
+      }
+    } else {
+      m_hosts.Add (node);
+    }
+  }
+
+  // Os endereços são atribuídos na ordem dos enlaces, então as interfaces previstas pelo índice são as reais
+  m_adjacency.Reserve (links.size ());
+  for (const auto& link : links) {
+    m_adjacency.AddLink (m_nodes.Get (link.node1)->GetId (), m_nodes.Get (link.node2)->GetId (), link.cost);
+  }
+  m_adjacency.Finalize ();
+
+  InternetStackHelper internet;
+  internet.SetIpv6StackInstall (false);
+  if (routingProtocol == "rip") {
+    RipHelper ripHelper;
+    SetRipMetrics (ripHelper, m_adjacency);
+    internet.SetRoutingHelper (ripHelper);
+  } else if (routingProtocol == "olsr") {
+    OlsrHelper olsrHelper;
+    internet.SetRoutingHelper (olsrHelper);
+  } else {
+    NS_LOG_ERROR ("Protocolo de roteamento inválido.");
+    return false;
+  }
+  NodeContainer localNodes, remoteNodes;
+  for (uint32_t i = 0; i < m_nodes.GetN (); ++i) {
+    (IsLocal (i) ? localNodes : remoteNodes).Add (m_nodes.Get (i));
+  }
+  internet.Install (localNodes);
+  if (remoteNodes.GetN () > 0) {
+    // O roteamento dos nós de outros processos roda no processo dono do nó
+    InternetStackHelper remoteInternet;
+    remoteInternet.SetIpv6StackInstall (false);
+    remoteInternet.Install (remoteNodes);
+  }
+
+  CreateDevices ();
+  AssignAddresses (subnets);
+  return true;
+}
+
+void TopologyBuilder::CreateDevices () {
+  const auto& links = m_topology.GetLinks ();
+  m_linkDevices.reserve (links.size ());
+
+  // Os atributos dos helpers só são alterados quando mudam de um enlace para o outro
+  uint64_t p2pRate = 0, csmaRate = 0;
+  Time p2pDelay = Time (-1), csmaDelay = Time (-1);
+  for (const auto& link : links) {
+    Ptr<Node> node1 = m_nodes.Get (link.node1);
+    Ptr<Node> node2 = m_nodes.Get (link.node2);
+    if (link.type == ChannelType::POINT_TO_POINT) {
+      if (link.dataRate != p2pRate) {
+        p2pRate = link.dataRate;
+        m_p2p.SetDeviceAttribute ("DataRate", DataRateValue (DataRate (p2pRate)));
+      }
+      if (link.delay != p2pDelay) {
+        p2pDelay = link.delay;
+        m_p2p.SetChannelAttribute ("Delay", TimeValue (p2pDelay));
+      }
+      m_linkDevices.push_back (m_p2p.Install (node1, node2));
+    } else {
+      if (link.dataRate != csmaRate) {
+        csmaRate = link.dataRate;
+        m_csma.SetChannelAttribute ("DataRate", DataRateValue (DataRate (csmaRate)));
+      }
+      if (link.delay != csmaDelay) {
+        csmaDelay = link.delay;
+        m_csma.SetChannelAttribute ("Delay", TimeValue (csmaDelay));
+      }
+      m_linkDevices.push_back (m_csma.Install (NodeContainer (node1, node2)));
+    }
+  }
+}
+
+void TopologyBuilder::AssignAddresses (SubnetAllocator& subnets) {
+  const auto& links = m_topology.GetLinks ();
+
+  std::vector<Ptr<Ipv4>> ipv4 (m_nodes.GetN ());
+  for (uint32_t i = 0; i < m_nodes.GetN (); ++i) {
+    ipv4[i] = m_nodes.Get (i)->GetObject<Ipv4> ();
+  }
+
+  // Mesmo procedimento do AssignSubnet, com o controle de tráfego instalado de uma vez no final
+  // nos dispositivos que ainda não têm uma fila raiz
+  const Ipv4Mask mask = subnets.GetMask ();
+  subnets.Reserve (subnets.GetN () + links.size ());
+  NetDeviceContainer queueDevices;
+  for (uint32_t i = 0; i < links.size (); ++i) {
+    const uint32_t subnet = subnets.Allocate ();
+    const uint32_t nodeIndex[2] = {links[i].node1, links[i].node2};
+    for (uint32_t j = 0; j < 2; ++j) {
+      Ptr<NetDevice> device = m_linkDevices[i].Get (j);
+      Ptr<Ipv4> nodeIpv4 = ipv4[nodeIndex[j]];
+      int32_t interface = nodeIpv4->AddInterface (device);
+      NS_ASSERT (static_cast<uint32_t> (interface) == (j == 0 ? m_adjacency.GetLink (i).interface1
+                                                              : m_adjacency.GetLink (i).interface2));
+      nodeIpv4->AddAddress (interface, Ipv4InterfaceAddress (subnets.GetHostAddress (subnet, j), mask));
+      nodeIpv4->SetMetric (interface, 1);
+      nodeIpv4->SetUp (interface);
+      Ptr<TrafficControlLayer> tc = device->GetNode ()->GetObject<TrafficControlLayer> ();
+      if (tc != nullptr && tc->GetRootQueueDiscOnDevice (device) == nullptr) {
+        queueDevices.Add (device);
+      }
+    }
+  }
+
+  TrafficControlHelper tcHelper = TrafficControlHelper::Default ();
+  tcHelper.Install (queueDevices);
+}
+
+Ptr<FailureSchedule> TopologyBuilder::ScheduleFailures (Time stop) const {
+  // As falhas de nó da descrição usam o índice do nó, e o motor de falhas usa o ID do ns-3
+  Ptr<FailureSchedule> schedule = Create<FailureSchedule> (m_adjacency, stop);
+  for (FailureDescription failure : m_topology.GetFailures ()) {
+    if (failure.target == FailureTarget::NODE) {
+      failure.element = m_nodes.Get (failure.element)->GetId ();
+    }
+    schedule->Add (failure);
+  }
+  for (RandomFailureDescription failure : m_topology.GetRandomFailures ()) {
+    if (failure.target == FailureTarget::NODE) {
+      failure.element = m_nodes.Get (failure.element)->GetId ();
+    }
+    schedule->AddRandom (failure);
+  }
+  schedule->Start ();
+  return schedule;
+}
+
+void TopologyBuilder::EnableCapture (Ptr<PacketCapture> capture) const {
+  const auto& links = m_topology.GetLinks ();
+  for (uint32_t i = 0; i < links.size (); ++i) {
+    const uint32_t nodeIndex[2] = {links[i].node1, links[i].node2};
+    const uint32_t dataLinkType = links[i].type == ChannelType::POINT_TO_POINT ? PcapHelper::DLT_PPP
+                                                                               : PcapHelper::DLT_EN10MB;
+    for (uint32_t j = 0; j < 2; ++j) {
+      if (IsLocal (nodeIndex[j])) {
+        capture->Add (NetDeviceContainer (m_linkDevices[i].Get (j)), dataLinkType);
+      }
+    }
+  }
+}
+
+} // namespace ns3
@@ -0,0 +1,124 @@
+#ifndef TOPOLOGY_BUILDER_H
+#define TOPOLOGY_BUILDER_H
+
+#include "ns3/adjacency-index.h"
+#include "ns3/csma-helper.h"
+#include "ns3/failure-schedule.h"
+#include "ns3/net-device-container.h"
+#include "ns3/node-container.h"
+#include "ns3/packet-capture.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/subnet-allocator.h"
+#include "ns3/topology-description.h"
+
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * Constrói os objetos do ns-3 a partir de uma TopologyDescription em uma única passada:
+ * cria os nós, instala a pilha IPv4 com o protocolo de roteamento, os dispositivos e os endereços.
+ *
+ * Cada enlace recebe a próxima sub-rede do SubnetAllocator, na ordem em que foi declarado, em vez
+ * de um SetBase/Assign por enlace. Os endereços são adicionados às interfaces nessa mesma ordem,
+ * então o índice de cada interface é conhecido antes da instalação e as métricas RIP podem ser
+ * passadas ao RipHelper de uma vez.
+ */
+class TopologyBuilder {
+public:
+  /**
+   * @param topology Descrição da topologia, que deve existir enquanto o construtor for usado.
+   */
+  TopologyBuilder (const TopologyDescription& topology);
+
+  /**
+   * Distribui os nós entre os processos da simulação distribuída. Deve ser chamada antes do Build.
+   *
+   * Todos os processos criam todos os nós, mas o protocolo de roteamento só é instalado nos nós
+   * locais; os demais recebem apenas a pilha IPv4 e os endereços, sem gerar eventos.
+   *
+   * @param systemIds Processo de cada nó, na ordem da descrição (ver TopologyPartitioner).
+   * @param systemId Processo atual.
+   */
+  void SetPartition (const std::vector<uint32_t>& systemIds, uint32_t systemId);
+
+  /**
+   * @param routingProtocol "rip" ou "olsr".
+   * @param subnets Alocador das sub-redes dos enlaces.
+   * @return false se o protocolo é inválido ou não há sub-redes suficientes para os enlaces.
+   */
+  bool Build (const std::string& routingProtocol, SubnetAllocator& subnets);
+
+  /**
+   * Agenda as falhas da descrição (programadas e aleatórias) em um FailureSchedule. Deve ser
+   * chamada depois do Build e antes dos demais eventos nos mesmos instantes.
+   *
+   * @param stop Fim da simulação.
+   * @return Motor de falhas, com os instantes dos eventos.
+   */
+  Ptr<FailureSchedule> ScheduleFailures (Time stop) const;
+
+  /**
+   * Adiciona à captura os dispositivos criados (só os dos nós locais, com partições).
+   */
+  void EnableCapture (Ptr<PacketCapture> capture) const;
+
+  Ptr<Node> GetNode (uint32_t index) const {
+    return m_nodes.Get (index);
+  }
+
+  const NodeContainer& GetNodes () const {
+    return m_nodes;
+  }
+
+  const NodeContainer& GetRouters () const {
+    return m_routers;
+  }
+
+  const NodeContainer& GetHosts () const {
+    return m_hosts;
+  }
+
+  /**
+   * @return Roteadores simulados por este processo (todos, sem partições).
+   */
+  const NodeContainer& GetLocalRouters () const {
+    return m_localRouters;
+  }
+
+  bool IsLocal (uint32_t index) const {
+    return m_systemIds.empty () || m_systemIds[index] == m_systemId;
+  }
+
+  NetDeviceContainer GetLinkDevices (uint32_t link) const {
+    return m_linkDevices[link];
+  }
+
+  /**
+   * Índice de adjacência por ID de nó. Os IDs dos enlaces são os índices da descrição.
+   */
+  const AdjacencyIndex& GetAdjacency () const {
+    return m_adjacency;
+  }
+
+private:
+  void CreateDevices ();
+  void AssignAddresses (SubnetAllocator& subnets);
+
+  const TopologyDescription& m_topology;
+  NodeContainer m_nodes;
+  NodeContainer m_routers;
+  NodeContainer m_hosts;
+  NodeContainer m_localRouters;
+  std::vector<uint32_t> m_systemIds;
+  uint32_t m_systemId;
+  std::vector<NetDeviceContainer> m_linkDevices;
+  AdjacencyIndex m_adjacency;
+  PointToPointHelper m_p2p;
+  CsmaHelper m_csma;
+};
+
+} // namespace ns3
+
+#endif /* TOPOLOGY_BUILDER_H */
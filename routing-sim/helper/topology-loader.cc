@@ -0,0 +1,318 @@
+#include "topology-loader.h"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <string_view>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TopologyLoader");
+
+namespace {
+
+const size_t MAX_TOKENS = 8;
+
+/**
+ * Separa uma linha em palavras, ignorando o que vier depois de '#'.
+ *
+ * @return Número de palavras, ou MAX_TOKENS + 1 se a linha tem palavras demais.
+ */
+size_t Tokenize (std::string_view line, std::string_view tokens[MAX_TOKENS]) {
+  size_t count = 0;
+  size_t i = 0;
+  while (i < line.size ()) {
+    while (i < line.size () && (line[i] == ' ' || line[i] == '\t' || line[i] == '\r')) {
+      ++i;
+    }
+    if (i == line.size () || line[i] == '#') {
+      break;
+    }
+    size_t start = i;
+    while (i < line.size () && line[i] != ' ' && line[i] != '\t' && line[i] != '\r' && line[i] != '#') {
+      ++i;
+    }
+    if (count == MAX_TOKENS) {
+      return MAX_TOKENS + 1;
+    }
+    tokens[count++] = line.substr (start, i - start);
+  }
+  return count;
+}
+
+/**
+ * Lê um número finito e não negativo no início da palavra e devolve o sufixo restante (unidade).
+ */
+bool ParseNumber (std::string_view token, double& value, std::string_view& unit) {
+  // strtod para no primeiro caractere que não continua o número. A palavra é seguida por um
+  // separador (espaço, tabulação, '\r', '#' ou '\n') ou pelo '\0' do fim do std::string do arquivo,
+  // e nenhum deles continua um número, então a leitura nunca passa do fim da palavra
+  char* end;
+  value = std::strtod (token.data (), &end);
+  size_t length = end - token.data ();
+  // strtod aceita "nan", "inf" e valores que estouram para infinito
+  if (length == 0 || length > token.size () || !std::isfinite (value) || value < 0) {
+    return false;
+  }
+  unit = token.substr (length);
+  return true;
+}
+
+bool ParseDouble (std::string_view token, double& value) {
+  char* end;
+  value = std::strtod (token.data (), &end);
+  return end == token.data () + token.size () && std::isfinite (value);
+}
+
+bool ParseDataRate (std::string_view token, uint64_t& dataRate) {
+  double value;
+  std::string_view unit;
+  if (!ParseNumber (token, value, unit)) {
+    return false;
+  }
+  double multiplier;
+  if (unit == "bps") {
+    multiplier = 1;
+  } else if (unit == "kbps" || unit == "Kbps") {
+    multiplier = 1e3;
+  } else if (unit == "Mbps") {
+    multiplier = 1e6;
+  } else if (unit == "Gbps") {
+    multiplier = 1e9;
+  } else {
+    return false;
+  }
+  // static_cast<double> (UINT64_MAX) arredonda para 2^64, o primeiro valor fora do intervalo
+  const double bps = value * multiplier;
+  if (bps >= static_cast<double> (UINT64_MAX)) {
+    return false;
+  }
+  dataRate = static_cast<uint64_t> (bps);
+  return dataRate > 0;
+}
+
+bool ParseTime (std::string_view token, Time& time) {
+  double value;
+  std::string_view unit;
+  if (!ParseNumber (token, value, unit)) {
+    return false;
+  }
+  // Nanossegundos por unidade; rejeita instantes que não cabem no contador de 64 bits do Time
+  double scale;
+  if (unit == "s") {
+    scale = 1e9;
+  } else if (unit == "ms") {
+    scale = 1e6;
+  } else if (unit == "us") {
+    scale = 1e3;
+  } else if (unit == "ns") {
+    scale = 1;
+  } else {
+    return false;
+  }
+  if (value * scale >= static_cast<double> (INT64_MAX)) {
+    return false;
+  }
+  time = NanoSeconds (value * scale);
+  return true;
+}
+
+bool ParseNodePair (const TopologyDescription& topology, std::string_view name1, std::string_view name2,
+                    uint32_t& node1, uint32_t& node2) {
+  node1 = topology.FindNode (std::string (name1));
+  node2 = topology.FindNode (std::string (name2));
+  return node1 != TopologyDescription::NOT_FOUND && node2 != TopologyDescription::NOT_FOUND && node1 != node2;
+}
+
+/**
+ * Lê o alvo de uma falha em tokens[1] (e tokens[2], se for um enlace): o primeiro enlace entre dois
+ * nós, um nó ou, se allowAll, '*' para todos os enlaces.
+ */
+bool ParseFailureTarget (const TopologyDescription& topology, const std::string_view tokens[], bool link,
+                         bool allowAll, FailureTarget& target, uint32_t& element) {
+  if (link) {
+    uint32_t node1, node2;
+    if (!ParseNodePair (topology, tokens[1], tokens[2], node1, node2)) {
+      return false;
+    }
+    target = FailureTarget::LINK;
+    element = topology.FindLink (node1, node2);
+  } else if (allowAll && tokens[1] == "*") {
+    target = FailureTarget::ALL_LINKS;
+    element = 0;
+  } else {
+    target = FailureTarget::NODE;
+    element = topology.FindNode (std::string (tokens[1]));
+  }
+  return element != TopologyDescription::NOT_FOUND;
+}
+
+bool ParseFailure (TopologyDescription& topology, const std::string_view tokens[], size_t count) {
+  std::string_view keyword = tokens[0];
+
+  if (keyword == "failure" || keyword == "flap") {
+    // Depois do alvo: queda e retorno, e no flap também o intervalo e as repetições
+    const size_t arguments = keyword == "failure" ? 2 : 4;
+    if (count != 2 + arguments && count != 3 + arguments) {
+      return false;
+    }
+    const bool link = count == 3 + arguments;
+    FailureDescription failure {FailureTarget::LINK, 0, Time (0), Time (0), 1, Time (0)};
+    if (!ParseFailureTarget (topology, tokens, link, false, failure.target, failure.element)) {
+      return false;
+    }
+    const std::string_view* values = tokens + (link ? 3 : 2);
+    if (!ParseTime (values[0], failure.down) || !ParseTime (values[1], failure.up) || failure.up <= failure.down) {
+      return false;
+    }
+    if (keyword == "flap") {
+      double repeat;
+      if (!ParseTime (values[2], failure.interval) || failure.interval <= Time (0) || !ParseDouble (values[3], repeat)
+          || repeat < 1 || repeat > UINT32_MAX || repeat != std::floor (repeat)) {
+        return false;
+      }
+      failure.repeat = static_cast<uint32_t> (repeat);
+    }
+    topology.AddFailure (failure);
+    return true;
+  }
+
+  if (keyword == "random") {
+    // Nó ou '*' com 4 ou 6 palavras, enlace com 5 ou 7
+    if (count < 4 || count > 7) {
+      return false;
+    }
+    const bool link = count % 2 == 1;
+    RandomFailureDescription failure {FailureTarget::LINK, 0, Time (0), Time (0), Time (0), Time::Max ()};
+    if (!ParseFailureTarget (topology, tokens, link, true, failure.target, failure.element)) {
+      return false;
+    }
+    const std::string_view* values = tokens + (link ? 3 : 2);
+    if (!ParseTime (values[0], failure.mtbf) || !ParseTime (values[1], failure.mttr)
+        || failure.mtbf <= Time (0) || failure.mttr <= Time (0)) {
+      return false;
+    }
+    if (count >= 6 && (!ParseTime (values[2], failure.start) || !ParseTime (values[3], failure.stop)
+                       || failure.stop <= failure.start)) {
+      return false;
+    }
+    topology.AddRandomFailure (failure);
+    return true;
+  }
+
+  return false;
+}
+
+bool ParseLine (TopologyDescription& topology, const std::string_view tokens[], size_t count) {
+  std::string_view keyword = tokens[0];
+
+  if (keyword == "node") {
+    if (count != 3 && count != 5) {
+      return false;
+    }
+    bool router;
+    if (tokens[2] == "router") {
+      router = true;
+    } else if (tokens[2] == "host") {
+      router = false;
+    } else {
+      return false;
+    }
+    double x = 0;
+    double y = 0;
+    if (count == 5 && (!ParseDouble (tokens[3], x) || !ParseDouble (tokens[4], y))) {
+      return false;
+    }
+    return topology.AddNode (std::string (tokens[1]), router, x, y) != TopologyDescription::NOT_FOUND;
+  }
+
+  if (keyword == "link") {
+    if (count != 6 && count != 7) {
+      return false;
+    }
+    uint32_t node1, node2;
+    if (!ParseNodePair (topology, tokens[1], tokens[2], node1, node2)) {
+      return false;
+    }
+    ChannelType type;
+    if (tokens[3] == "p2p") {
+      type = ChannelType::POINT_TO_POINT;
+    } else if (tokens[3] == "csma") {
+      type = ChannelType::CSMA;
+    } else {
+      return false;
+    }
+    uint64_t dataRate;
+    Time delay;
+    if (!ParseDataRate (tokens[4], dataRate) || !ParseTime (tokens[5], delay)) {
+      return false;
+    }
+    double cost = 1;
+    if (count == 7 && (!ParseDouble (tokens[6], cost) || cost < 1 || cost > 15 || cost != static_cast<uint8_t> (cost))) {
+      return false;
+    }
+    topology.AddLink (node1, node2, type, dataRate, delay, static_cast<uint8_t> (cost));
+    return true;
+  }
+
+  return ParseFailure (topology, tokens, count);
+}
+
+/**
+ * Lê o arquivo de uma vez e passa cada linha com palavras para parse.
+ */
+bool LoadFile (const std::string& fileName, const char* kind, TopologyDescription& topology,
+               bool (*parse) (TopologyDescription&, const std::string_view[], size_t)) {
+  std::ifstream file (fileName, std::ios::binary | std::ios::ate);
+  if (!file) {
+    NS_LOG_ERROR ("Não foi possível abrir o arquivo de " << kind << " " << fileName);
+    return false;
+  }
+  std::string content (static_cast<size_t> (file.tellg ()), '\0');
+  file.seekg (0);
+  file.read (&content[0], content.size ());
+
+  // Cada linha declara no máximo um nó ou enlace, então o número de linhas limita os dois vetores
+  // (um arquivo de falhas é lido depois da topologia, que já está completa)
+  if (topology.GetNodes ().empty ()) {
+    size_t lines = std::count (content.begin (), content.end (), '\n') + 1;
+    topology.Reserve (lines, lines);
+  }
+
+  std::string_view text (content);
+  std::string_view tokens[MAX_TOKENS];
+  size_t lineNumber = 0;
+  while (!text.empty ()) {
+    size_t end = text.find ('\n');
+    std::string_view line = text.substr (0, end);
+    text.remove_prefix (end == std::string_view::npos ? text.size () : end + 1);
+    ++lineNumber;
+
+    size_t count = Tokenize (line, tokens);
+    if (count == 0) {
+      continue;
+    }
+    if (count > MAX_TOKENS || !parse (topology, tokens, count)) {
+      NS_LOG_ERROR (fileName << ":" << lineNumber << ": declaração inválida: " << line);
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+bool LoadTopology (const std::string& fileName, TopologyDescription& topology) {
+  return LoadFile (fileName, "topologia", topology, &ParseLine);
+}
+
+bool LoadFailures (const std::string& fileName, TopologyDescription& topology) {
+  topology.ClearFailures ();
+  return LoadFile (fileName, "falhas", topology, &ParseFailure);
+}
+
+} // namespace ns3
@@ -0,0 +1,49 @@
+#ifndef TOPOLOGY_LOADER_H
+#define TOPOLOGY_LOADER_H
+
+#include "ns3/topology-description.h"
+
+#include <string>
+
+namespace ns3 {
+
+/**
+ * Lê uma topologia de um arquivo texto. Cada linha contém uma declaração e '#' inicia um comentário:
+ *
+ *   node <nome> <router|host> [x y]
+ *   link <nó> <nó> <p2p|csma> <taxa> <atraso> [custo]
+ *   failure <nó> [nó] <queda> <retorno>
+ *   flap <nó> [nó] <queda> <retorno> <intervalo> <repetições>
+ *   random <nó|*> [nó] <mtbf> <mttr> [início fim]
+ *
+ * A taxa aceita os sufixos bps, kbps, Mbps e Gbps; atraso e tempos de falha aceitam s, ms, us e ns
+ * (ex.: "link Router1 Router2 csma 100Mbps 6560ns 2", "failure Router1 Router2 100s 200s").
+ * Os nós devem ser declarados antes dos enlaces que os usam e as falhas se referem ao primeiro
+ * enlace declarado entre os dois nós.
+ *
+ * Uma falha com um único nó derruba todos os enlaces do nó. O flap repete a falha, com o elemento
+ * ativo por <intervalo> entre as quedas (ex.: "flap Router1 Router2 100s 102s 3s 10"). O random
+ * sorteia quedas com tempo médio entre falhas <mtbf> e tempo médio de reparo <mttr>, na janela
+ * dada ou durante toda a simulação; com '*', cada enlace da topologia falha de forma independente
+ * (ex.: "random * 600s 5s 50s 250s").
+ *
+ * O arquivo é lido de uma vez e percorrido sem cópias intermediárias, de forma que grafos com
+ * dezenas de milhares de nós são carregados em uma fração do tempo de construção da simulação.
+ *
+ * @param fileName Caminho do arquivo.
+ * @param topology Descrição preenchida com o conteúdo do arquivo.
+ * @return false se o arquivo não pôde ser lido ou contém uma linha inválida.
+ */
+bool LoadTopology (const std::string& fileName, TopologyDescription& topology);
+
+/**
+ * Substitui as falhas da topologia pelas de um arquivo que só contém declarações failure, flap e
+ * random, no formato do LoadTopology. Permite simular vários cenários de falhas na mesma topologia.
+ *
+ * @return false se o arquivo não pôde ser lido ou contém uma linha inválida.
+ */
+bool LoadFailures (const std::string& fileName, TopologyDescription& topology);
+
+} // namespace ns3
+
+#endif /* TOPOLOGY_LOADER_H */
@@ -0,0 +1,532 @@
+#include "topology-scenario.h"
+#include "animation-helper.h"
+#include "distributed-helper.h"
+#include "scenario-helper.h"
+#include "topology-builder.h"
+#include "topology-loader.h"
+
+#include "ns3/animation-interface.h"
+#include "ns3/control-overhead.h"
+#include "ns3/core-module.h"
+#include "ns3/failure-schedule.h"
+#include "ns3/flow-monitor-module.h"
+#include "ns3/flow-stats.h"
+#include "ns3/flow-stats-exporter.h"
+#include "ns3/internet-module.h"
+#include "ns3/latency-monitor.h"
+#include "ns3/loss-timeline.h"
+#include "ns3/packet-capture.h"
+#include "ns3/route-change-log.h"
+#include "ns3/routing-table-tracker.h"
+#include "ns3/run-summary.h"
+#include "ns3/sequence-gap-detector.h"
+#include "ns3/subnet-allocator.h"
+#include "ns3/topology-description.h"
+#include "ns3/topology-generator.h"
+#include "ns3/topology-partitioner.h"
+#include "ns3/udp-client-server-helper.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+namespace ns3 {
+
+#define SIMULATION_TIME 300.0
+#define UDP_TRANSMISSION_TIME 50.0
+#define UDP_PACKET_INTERVAL 0.1
+#define UDP_MAX_PACKETS 10000
+#define LOSS_TIMELINE_WINDOW 10.0
+
+NS_LOG_COMPONENT_DEFINE ("TopologyScenario");
+
+int RunTopologyScenario (int argc, char* argv[], const std::string& defaultTopology) {
+  std::string topologyFile = defaultTopology;
+
+  std::string generator = "";
+  GeneratorConfig generatorConfig;
+  std::string linkCost = "ns3::ConstantRandomVariable[Constant=1]";
+
+  std::string sender = "T";
+  std::string receiver = "R";
+
+  std::string routingProtocol = "rip";
+
+  std::string subfolder = ".";
+
+  std::string trackerMode = "event";
+
+  double pollFloor = 0.1;
+  double pollCeiling = 5.0;
+
+  bool routeLog = false;
+  bool controlLog = false;
+  bool latency = false;
+
+  bool lossTimeline = false;
+  double lossResolution = 0.1;
+
+  bool animation = false;
+  AnimationConfig animationConfig;
+  double animationStart = 0;
+  double animationStop = SIMULATION_TIME;
+
+  std::string captureFilter = "all";
+  uint32_t snapLen = 65535;
+  std::string captureNodes = "";
+
+  std::string flowExport = "";
+  double flowExportInterval = 1.0;
+
+  std::string addressPool = "10.0.0.0/8";
+  uint32_t subnetPrefix = 30;
+
+  std::string failuresFile = "";
+  double failureDown = -1;
+  double failureUp = -1;
+
+  std::string summaryFile = "";
+
+  bool distributed = false;
+  double minLookahead = 0;
+
+  CommandLine cmd;
+  cmd.AddValue ("topology", "Arquivo com a descrição da topologia", topologyFile);
+  cmd.AddValue ("generator", "Gera uma topologia sintética em vez de ler o arquivo (grid, ring, waxman ou ba)", generator);
+  cmd.AddValue ("routers", "Número de roteadores da topologia gerada", generatorConfig.routers);
+  cmd.AddValue ("degree", "Grau médio da topologia gerada (waxman e ba)", generatorConfig.degree);
+  cmd.AddValue ("waxmanBeta", "Parâmetro beta do modelo de Waxman", generatorConfig.waxmanBeta);
+  cmd.AddValue ("linkCost", "Distribuição dos custos RIP dos enlaces gerados", linkCost);
+  cmd.AddValue ("sender", "Nó que transmite os pacotes UDP", sender);
+  cmd.AddValue ("receiver", "Nó que recebe os pacotes UDP", receiver);
+  cmd.AddValue ("routingProtocol", "Protocolo de roteamento (rip ou olsr)", routingProtocol);
+  cmd.AddValue ("subfolder", "Subpasta para os arquivos de saída", subfolder);
+  cmd.AddValue ("trackerMode", "Monitoramento das tabelas de roteamento (event, adaptive ou polling)", trackerMode);
+  cmd.AddValue ("pollFloor", "Menor intervalo do polling adaptativo (s)", pollFloor);
+  cmd.AddValue ("pollCeiling", "Maior intervalo do polling adaptativo (s)", pollCeiling);
+  cmd.AddValue ("routeLog", "Registra as alterações de rotas em <arquivo>_rotas.csv", routeLog);
+  cmd.AddValue ("controlLog", "Grava o tráfego de controle de roteamento de cada nó em cada fase em <arquivo>_controle.csv", controlLog);
+  cmd.AddValue ("animation", "Grava a animação do NetAnim em <arquivo>.xml", animation);
+  cmd.AddValue ("animationStart", "Início da janela gravada na animação (s)", animationStart);
+  cmd.AddValue ("animationStop", "Fim da janela gravada na animação (s)", animationStop);
+  cmd.AddValue ("animationPackets", "Grava os pacotes na animação; false grava só os nós e enlaces", animationConfig.packets);
+  cmd.AddValue ("animationCompress", "Comprime a animação com o gzip durante a simulação (<arquivo>.xml.gz)", animationConfig.compress);
+  cmd.AddValue ("captureFilter", "Classes de pacotes gravadas em <arquivo>.pcapng (routing, app, other, all ou none)", captureFilter);
+  cmd.AddValue ("snapLen", "Número máximo de bytes gravados de cada pacote na captura", snapLen);
+  cmd.AddValue ("captureNodes", "Nós capturados, separados por vírgulas; vazio captura todos", captureNodes);
+  cmd.AddValue ("flowExport", "Exporta as estatísticas de fluxo em <arquivo>_fluxos (csv, jsonl ou binary)", flowExport);
+  cmd.AddValue ("flowExportInterval", "Intervalo entre as exportações das estatísticas de fluxo (s)", flowExportInterval);
+  cmd.AddValue ("latency", "Mede os percentis de latência dos pacotes e grava em <arquivo>_latencia.csv", latency);
+  cmd.AddValue ("lossTimeline", "Registra os pacotes enviados e perdidos por intervalo em <arquivo>_perdas.csv", lossTimeline);
+  cmd.AddValue ("lossResolution", "Tamanho dos intervalos da linha do tempo de perdas (s)", lossResolution);
+  cmd.AddValue ("addressPool", "Bloco de endereços dos enlaces", addressPool);
+  cmd.AddValue ("subnetPrefix", "Prefixo das sub-redes dos enlaces (24, 30 ou 31)", subnetPrefix);
+  cmd.AddValue ("failures", "Arquivo com as falhas (failure, flap e random), que substituem as da topologia", failuresFile);
+  cmd.AddValue ("failureDown", "Instante de queda de todas as falhas da topologia (s); 0 remove as falhas", failureDown);
+  cmd.AddValue ("failureUp", "Instante de retorno de todas as falhas da topologia (s)", failureUp);
+  cmd.AddValue ("summary", "Grava os resultados em uma linha chave=valor neste arquivo (usado pelo sweep)", summaryFile);
+  cmd.AddValue ("distributed", "Divide a simulação entre os processos do mpirun", distributed);
+  cmd.AddValue ("minLookahead", "Enlaces com atraso menor que este valor não são divididos entre processos (s)", minLookahead);
+  cmd.Parse (argc, argv);
+
+  TrackingConfig tracking;
+  if (!ParseTrackingMode (trackerMode, tracking.mode)) {
+    NS_LOG_ERROR("Modo de monitoramento inválido.");
+    return 1;
+  }
+  tracking.pollFloor = Seconds (pollFloor);
+  tracking.pollCeiling = Seconds (std::max (pollCeiling, pollFloor));
+
+  FlowExportFormat flowExportFormat = FlowExportFormat::CSV;
+  if (!flowExport.empty () && !ParseFlowExportFormat (flowExport, flowExportFormat)) {
+    NS_LOG_ERROR("Formato de exportação das estatísticas de fluxo inválido.");
+    return 1;
+  }
+  if (animation && animationStart >= animationStop) {
+    NS_LOG_ERROR("O início da janela da animação deve ser anterior ao fim.");
+    return 1;
+  }
+  animationConfig.start = Seconds (animationStart);
+  animationConfig.stop = Seconds (animationStop);
+
+  uint8_t captureClasses = 0;
+  if (!ParseCaptureFilter (captureFilter, captureClasses)) {
+    NS_LOG_ERROR("Filtro de captura inválido.");
+    return 1;
+  }
+  if (lossTimeline && lossResolution <= 0) {
+    NS_LOG_ERROR("O tamanho dos intervalos da linha do tempo de perdas deve ser positivo.");
+    return 1;
+  }
+
+  SubnetAllocator subnets;
+  if (subnetPrefix > 31 || !subnets.SetPool (addressPool, subnetPrefix)) {
+    NS_LOG_ERROR("Bloco de endereços ou prefixo inválido.");
+    return 1;
+  }
+
+  std::string topologyName = generator.empty () ? std::filesystem::path (topologyFile).stem ().string ()
+                                                : generator + std::to_string (generatorConfig.routers);
+  std::string fileName = subfolder + "/" + topologyName + "_" + routingProtocol;
+
+  // ==============================================================================================
+  TopologyDescription topology;
+  if (generator.empty ()) {
+    NS_LOG_INFO("** Lendo a topologia...");
+    if (!LoadTopology (topologyFile, topology)) {
+      return 1;
+    }
+  } else {
+    NS_LOG_INFO("** Gerando a topologia...");
+    ObjectFactory costFactory;
+    std::istringstream costStream (linkCost);
+    if (!(costStream >> costFactory)) {
+      NS_LOG_ERROR("Distribuição de custos inválida.");
+      return 1;
+    }
+    generatorConfig.cost = costFactory.Create<RandomVariableStream> ();
+    if (!GenerateTopology (generator, generatorConfig, topology)) {
+      NS_LOG_ERROR("Gerador de topologia inválido.");
+      return 1;
+    }
+  }
+  if (!failuresFile.empty () && !LoadFailures (failuresFile, topology)) {
+    return 1;
+  }
+  if (failureDown == 0) {
+    topology.ClearFailures ();
+  } else if (failureDown > 0) {
+    if (failureUp <= failureDown) {
+      NS_LOG_ERROR("O retorno das falhas deve ser posterior à queda.");
+      return 1;
+    }
+    topology.SetFailureTimes (Seconds (failureDown), Seconds (failureUp));
+  }
+  uint32_t senderIndex = topology.FindNode (sender);
+  uint32_t receiverIndex = topology.FindNode (receiver);
+  if (senderIndex == TopologyDescription::NOT_FOUND || receiverIndex == TopologyDescription::NOT_FOUND) {
+    NS_LOG_ERROR("Nó transmissor ou receptor inexistente na topologia.");
+    return 1;
+  }
+
+  // ==============================================================================================
+  TopologyBuilder builder (topology);
+  if (distributed) {
+    if (!EnableDistributedSimulation (&argc, &argv)) {
+      NS_LOG_ERROR("O ns-3 foi compilado sem suporte a MPI (./waf configure --enable-mpi).");
+      return 1;
+    }
+    NS_LOG_INFO("** Dividindo a topologia entre " << GetSystemCount () << " processos...");
+    TopologyPartitioner partitioner (topology);
+    partitioner.Pin (senderIndex);
+    partitioner.Pin (receiverIndex);
+    partitioner.AddTraffic (senderIndex, receiverIndex);
+    partitioner.SetMinLookahead (Seconds (minLookahead));
+    std::vector<uint32_t> partition = partitioner.Partition (GetSystemCount ());
+    builder.SetPartition (partition, GetSystemId ());
+
+    if (GetSystemId () == 0) {
+      PartitionStats stats = partitioner.Evaluate (partition, GetSystemCount ());
+      std::cout << "Nós por processo:";
+      for (uint32_t count : stats.nodes) {
+        std::cout << " " << count;
+      }
+      std::cout << "\nEnlaces entre processos: " << stats.cutLinks << "\n";
+      if (stats.cutLinks == 0) {
+        std::cout << "Lookahead: sem enlaces entre processos (a topologia não pôde ser dividida)\n";
+      } else {
+        std::cout << "Lookahead: " << stats.lookahead.GetSeconds () << " s\n";
+      }
+    }
+  }
+  // O processo 0 simula T e R e imprime os resultados
+  bool mainProcess = GetSystemId () == 0;
+
+  NS_LOG_INFO("** Criando nós, enlaces e pilha de protocolos de internet IPv4 e roteamento...");
+  if (!builder.Build (routingProtocol, subnets)) {
+    return FinishSimulation (1);
+  }
+  NodeContainer routers = builder.GetLocalRouters ();
+  NodeContainer nodes = builder.GetHosts ();
+  Ptr<Node> t = builder.GetNode (senderIndex);
+  Ptr<Node> r = builder.GetNode (receiverIndex);
+
+  // ==============================================================================================
+  NS_LOG_INFO("** Criando aplicações de envio de pacotes UDP...");
+  uint16_t udpPort = 9;
+
+  ApplicationContainer serverApps, clientApps;
+  if (mainProcess) {
+    UdpServerHelper server (udpPort);
+    serverApps = server.Install (r);
+
+    Ipv4Address receiverAddress = r->GetObject<Ipv4>()->GetAddress(1,0).GetLocal();
+    UdpClientHelper client (receiverAddress, udpPort);
+    client.SetAttribute ("Interval", TimeValue (Seconds (UDP_PACKET_INTERVAL)));
+    client.SetAttribute ("PacketSize", UintegerValue (1024));
+    client.SetAttribute ("MaxPackets", UintegerValue (UDP_MAX_PACKETS));
+    clientApps = client.Install (t);
+    clientApps.Start (Seconds (UDP_TRANSMISSION_TIME));
+  }
+
+  // ==============================================================================================
+  // Configura a animação da simulação, se pedida (o NetAnim não suporta a simulação distribuída)
+  std::unique_ptr<Animation> anim;
+  if (animation && !distributed) {
+    const auto& nodeDescriptions = topology.GetNodes ();
+    for (uint32_t i = 0; i < nodeDescriptions.size (); ++i) {
+      AnimationInterface::SetConstantPosition (builder.GetNode (i), nodeDescriptions[i].x, nodeDescriptions[i].y);
+    }
+    anim = std::make_unique<Animation> (fileName, animationConfig);
+    for (uint32_t i = 0; i < nodeDescriptions.size (); ++i) {
+      Ptr<Node> node = builder.GetNode (i);
+      anim->UpdateNodeDescription (node, nodeDescriptions[i].name);
+      if (!nodeDescriptions[i].router) {
+        anim->UpdateNodeSize (node, 2.0, 2.0);
+        anim->UpdateNodeColor (node, 255, 255, 0);
+      }
+    }
+  }
+
+  // ==============================================================================================
+  // Simula as quedas e retornos de enlace descritos na topologia
+  Ptr<FailureSchedule> failures = builder.ScheduleFailures (Seconds (SIMULATION_TIME));
+
+  // As fases da simulação são delimitadas pelos instantes das falhas
+  std::vector<Time> phaseLimits = failures->GetEventTimes ();
+  phaseLimits.insert (phaseLimits.begin (), Seconds (0.0));
+  phaseLimits.push_back (Seconds (SIMULATION_TIME));
+  phaseLimits.erase (std::unique (phaseLimits.begin (), phaseLimits.end ()), phaseLimits.end ());
+
+  // ==============================================================================================
+  // Configura o monitoramento da rede
+  Ptr<PacketCapture> capture;
+  if (captureClasses != 0) {
+    // Na simulação distribuída, cada processo grava os pacotes dos seus nós
+    std::string rank = distributed ? "_" + std::to_string (GetSystemId ()) : "";
+    capture = Create<PacketCapture> (fileName + rank + ".pcapng", captureClasses, snapLen, udpPort);
+    capture->SetNodes (captureNodes);
+    builder.EnableCapture (capture);
+  }
+
+  FlowMonitorHelper flowmon;
+  Ptr<FlowMonitor> monitor = flowmon.Install(nodes);
+  Ptr<FlowStatsWindow> flowWindow = Create<FlowStatsWindow> (monitor);
+  for (size_t i = 1; i < phaseLimits.size () && mainProcess; ++i) {
+    Simulator::Schedule (phaseLimits[i], &PrintTotalFlowStats, flowWindow);
+  }
+
+  // Tráfego de controle do protocolo de roteamento em cada fase, contado nos nós deste processo
+  NodeContainer localNodes;
+  for (uint32_t i = 0; i < builder.GetNodes ().GetN (); ++i) {
+    if (builder.IsLocal (i)) {
+      localNodes.Add (builder.GetNode (i));
+    }
+  }
+  Ptr<ControlOverhead> controlOverhead = Create<ControlOverhead> ();
+  controlOverhead->Install (localNodes);
+  for (size_t i = 1; i < phaseLimits.size (); ++i) {
+    Simulator::Schedule (phaseLimits[i], &ControlOverhead::Advance, controlOverhead);
+  }
+
+  // Exportação periódica das estatísticas de fluxo
+  Ptr<FlowStatsExporter> flowExporter;
+  if (!flowExport.empty () && mainProcess) {
+    flowExporter = Create<FlowStatsExporter> (monitor, flowmon.GetClassifier (),
+                                              fileName + "_fluxos" + GetFlowExportExtension (flowExportFormat),
+                                              flowExportFormat);
+    flowExporter->Start (Seconds (flowExportInterval));
+  }
+
+  // Percentis de latência dos pacotes recebidos em cada fase
+  Ptr<LatencyMonitor> latencyMonitor;
+  if (latency && mainProcess) {
+    latencyMonitor = Create<LatencyMonitor> (fileName + "_latencia.csv");
+    latencyMonitor->Install (serverApps);
+    for (size_t i = 1; i < phaseLimits.size (); ++i) {
+      Simulator::Schedule (phaseLimits[i], &PrintLatencyStats, latencyMonitor);
+    }
+  }
+
+  // Linha do tempo das perdas em torno de cada queda e retorno de enlace
+  Ptr<LossTimeline> lossTimelineMonitor;
+  if (lossTimeline && mainProcess) {
+    lossTimelineMonitor = Create<LossTimeline> (Seconds (lossResolution),
+                                                std::ceil (LOSS_TIMELINE_WINDOW / lossResolution),
+                                                fileName + "_perdas.csv");
+    lossTimelineMonitor->Install (clientApps, serverApps);
+    for (size_t i = 1; i + 1 < phaseLimits.size (); ++i) {
+      lossTimelineMonitor->AddEvent (phaseLimits[i]);
+    }
+  }
+
+  // Interrupção do tráfego de T para R em cada queda e retorno de enlace
+  Ptr<SequenceGapDetector> gapDetector = Create<SequenceGapDetector> ();
+  if (mainProcess) {
+    gapDetector->Install (serverApps);
+    for (size_t i = 1; i + 1 < phaseLimits.size (); ++i) {
+      gapDetector->AddEvent (phaseLimits[i]);
+    }
+  }
+
+  std::vector<Ptr<NetworkConvergenceTracker>> convergence;
+  for (size_t i = 1; i < phaseLimits.size (); ++i) {
+    Ptr<NetworkConvergenceTracker> tracker = Create<NetworkConvergenceTracker> (routers, tracking);
+    Simulator::Schedule (phaseLimits[i - 1], &NetworkConvergenceTracker::Start, tracker);
+    if (i > 1) {
+      Simulator::Schedule (phaseLimits[i - 1], &NetworkConvergenceTracker::NotifyLinkEvent, tracker);
+    }
+    Simulator::Schedule (phaseLimits[i], &NetworkConvergenceTracker::Stop, tracker);
+    convergence.push_back (tracker);
+  }
+
+  // Registro das alterações de rotas durante toda a simulação
+  Ptr<RouteChangeLog> routeChangeLog;
+  Ptr<NetworkConvergenceTracker> routeChanges;
+  if (routeLog) {
+    std::string rank = distributed ? "_" + std::to_string (GetSystemId ()) : "";
+    routeChangeLog = Create<RouteChangeLog> (fileName + rank + "_rotas.csv");
+    routeChanges = Create<NetworkConvergenceTracker> (routers, tracking, routeChangeLog);
+    Simulator::Schedule (Seconds (0.0), &NetworkConvergenceTracker::Start, routeChanges);
+    for (size_t i = 1; i + 1 < phaseLimits.size (); ++i) {
+      Simulator::Schedule (phaseLimits[i], &NetworkConvergenceTracker::NotifyLinkEvent, routeChanges);
+    }
+    Simulator::Schedule (Seconds (SIMULATION_TIME), &NetworkConvergenceTracker::Stop, routeChanges);
+  }
+
+  // ==============================================================================================
+  NS_LOG_INFO("** Executando simulação...");
+  Simulator::Stop (Seconds (SIMULATION_TIME));
+  Simulator::Run();
+
+  if (routeChangeLog != nullptr) {
+    routeChangeLog->Flush ();
+  }
+  if (flowExporter != nullptr) {
+    flowExporter->Stop ();
+  }
+  if (capture != nullptr) {
+    capture->Flush ();
+  }
+  if (latencyMonitor != nullptr) {
+    latencyMonitor->Flush ();
+  }
+  if (lossTimelineMonitor != nullptr) {
+    lossTimelineMonitor->Finish ();
+  }
+  gapDetector->Finish ();
+
+  // Cada processo monitora os seus roteadores; a convergência da rede é a do último deles
+  std::vector<double> convergenceTimes;
+  for (const auto& tracker : convergence) {
+    convergenceTimes.push_back (GetGlobalMaximum (tracker->GetNetworkConvergenceTime().GetSeconds()));
+  }
+
+  if (mainProcess) {
+    std::cout << std::endl << "Tempos de convergência do protocolo " << routingProtocol << ":\n";
+    for (size_t i = 0; i < convergenceTimes.size (); ++i) {
+      std::cout << "Fase de " << phaseLimits[i].GetSeconds () << " s a " << phaseLimits[i + 1].GetSeconds () << " s: "
+                << convergenceTimes[i] << " s\n";
+    }
+  }
+
+  // Cada processo conta o tráfego dos seus nós
+  std::vector<ControlOverhead::Window> controlWindows = controlOverhead->GetWindows ();
+  for (auto& window : controlWindows) {
+    window.total.txPackets = GetGlobalSum (window.total.txPackets);
+    window.total.txBytes = GetGlobalSum (window.total.txBytes);
+    window.total.rxPackets = GetGlobalSum (window.total.rxPackets);
+    window.total.rxBytes = GetGlobalSum (window.total.rxBytes);
+  }
+  if (controlLog) {
+    std::string rank = distributed ? "_" + std::to_string (GetSystemId ()) : "";
+    controlOverhead->Write (fileName + rank + "_controle.csv");
+  }
+
+  if (mainProcess) {
+    std::cout << "\nTráfego de controle do protocolo " << routingProtocol << ":\n";
+    PrintControlOverhead (controlWindows);
+
+    const auto& outages = gapDetector->GetOutages ();
+    if (!outages.empty ()) {
+      std::cout << "\nInterrupção do tráfego de " << sender << " para " << receiver << ":\n";
+    }
+    for (size_t i = 0; i < outages.size (); ++i) {
+      std::ostringstream label;
+      label << "Evento em " << outages[i].event.GetSeconds () << " s";
+      PrintDataPlaneOutage (label.str (), outages[i], Seconds (convergenceTimes[i + 1]));
+    }
+    if (lossTimelineMonitor != nullptr) {
+      PrintOutages (lossTimelineMonitor);
+    }
+  }
+
+  int exitCode = 0;
+  if (mainProcess && !summaryFile.empty ()) {
+    RunSummary summary;
+    for (size_t i = 0; i < convergenceTimes.size (); ++i) {
+      summary.Add ("convergence_" + std::to_string (i), convergenceTimes[i]);
+    }
+    FlowSummary flows = GetTotalFlowSummary (monitor);
+    summary.Add ("tx_packets", flows.txPackets);
+    summary.Add ("rx_packets", flows.rxPackets);
+    summary.Add ("lost_packets", flows.lostPackets);
+    summary.Add ("loss_ratio", flows.GetLossRatio ());
+    summary.Add ("throughput_mbps", flows.GetThroughput (Seconds (SIMULATION_TIME)));
+    summary.Add ("delay_s", flows.GetDelay ());
+    summary.Add ("jitter_s", flows.GetJitter ());
+    const auto& trafficOutages = gapDetector->GetOutages ();
+    for (size_t i = 0; i < trafficOutages.size (); ++i) {
+      std::string suffix = "_" + std::to_string (i + 1);
+      summary.Add ("traffic_outage_s" + suffix, trafficOutages[i].GetDuration ().GetSeconds ());
+      summary.Add ("traffic_recovery_s" + suffix, trafficOutages[i].GetRecoveryTime ().GetSeconds ());
+    }
+    if (lossTimelineMonitor != nullptr) {
+      // A interrupção do evento i é a do início da fase i + 1
+      const auto& outages = lossTimelineMonitor->GetOutages ();
+      for (size_t i = 0; i < outages.size (); ++i) {
+        std::string suffix = "_" + std::to_string (i + 1);
+        summary.Add ("outage_s" + suffix, outages[i].GetDuration ().GetSeconds ());
+        summary.Add ("recovery_s" + suffix, outages[i].GetRecoveryTime ().GetSeconds ());
+      }
+    }
+    ControlOverhead::Counters controlTotal;
+    for (size_t i = 0; i < controlWindows.size (); ++i) {
+      std::string suffix = "_" + std::to_string (i);
+      summary.Add ("control_packets" + suffix, controlWindows[i].total.txPackets);
+      summary.Add ("control_bytes" + suffix, controlWindows[i].total.txBytes);
+      controlTotal.txPackets += controlWindows[i].total.txPackets;
+      controlTotal.txBytes += controlWindows[i].total.txBytes;
+    }
+    summary.Add ("control_packets", controlTotal.txPackets);
+    summary.Add ("control_bytes", controlTotal.txBytes);
+    const auto& windows = flowWindow->GetWindows ();
+    for (size_t i = 0; i < windows.size (); ++i) {
+      const FlowSummary& phase = windows[i].total;
+      std::string suffix = "_" + std::to_string (i);
+      summary.Add ("loss_ratio" + suffix, phase.GetLossRatio ());
+      summary.Add ("throughput_mbps" + suffix, phase.GetThroughput (windows[i].end - windows[i].start));
+      summary.Add ("delay_s" + suffix, phase.GetDelay ());
+      summary.Add ("jitter_s" + suffix, phase.GetJitter ());
+      if (latencyMonitor != nullptr && i < latencyMonitor->GetWindows ().size ()) {
+        const LatencyMonitor::Window& latencyWindow = latencyMonitor->GetWindows ()[i];
+        summary.Add ("latency_p50_s" + suffix, latencyWindow.p50.GetSeconds ());
+        summary.Add ("latency_p99_s" + suffix, latencyWindow.p99.GetSeconds ());
+        summary.Add ("latency_p999_s" + suffix, latencyWindow.p999.GetSeconds ());
+      }
+    }
+    if (!summary.Write (summaryFile)) {
+      NS_LOG_ERROR("Não foi possível gravar o resumo.");
+      exitCode = 1;
+    }
+  }
+
+  NS_LOG_INFO("** Simulação finalizada.");
+  return FinishSimulation (exitCode);
+}
+
+} // namespace ns3
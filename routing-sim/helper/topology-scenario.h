@@ -0,0 +1,21 @@
+#ifndef TOPOLOGY_SCENARIO_H
+#define TOPOLOGY_SCENARIO_H
+
+#include <string>
+
+namespace ns3 {
+
+/**
+ * Executa o cenário genérico: lê (ou gera) a topologia, simula as suas falhas e mede a convergência,
+ * o tráfego e o tráfego de controle em cada fase. É o corpo de topologia.cc e dos cenários
+ * topologia1 a topologia3, que só mudam a topologia padrão; as opções de linha de comando estão
+ * descritas em topologia.cc.
+ *
+ * @param defaultTopology Arquivo de topologia usado quando --topology não é passado.
+ * @return Código de saída do programa.
+ */
+int RunTopologyScenario (int argc, char* argv[], const std::string& defaultTopology);
+
+} // namespace ns3
+
+#endif /* TOPOLOGY_SCENARIO_H */
@@ -0,0 +1,92 @@
+#include "adjacency-index.h"
+
+#include <algorithm>
+
+namespace ns3 {
+
+void AdjacencyIndex::Reserve (size_t links) {
+  m_links.reserve (links);
+}
+
+uint32_t AdjacencyIndex::AddLink (uint32_t node1, uint32_t node2, uint32_t interface1, uint32_t interface2,
+                                  uint8_t cost) {
+  // Mantém a previsão da outra sobrecarga depois das interfaces já ocupadas
+  uint32_t nodes = std::max (node1, node2) + 1;
+  if (m_nextInterface.size () < nodes) {
+    m_nextInterface.resize (nodes, 1);
+  }
+  m_nextInterface[node1] = std::max (m_nextInterface[node1], interface1 + 1);
+  m_nextInterface[node2] = std::max (m_nextInterface[node2], interface2 + 1);
+  m_links.push_back ({node1, node2, interface1, interface2, cost});
+  return m_links.size () - 1;
+}
+
+uint32_t AdjacencyIndex::AddLink (uint32_t node1, uint32_t node2, uint8_t cost) {
+  uint32_t nodes = std::max (node1, node2) + 1;
+  if (m_nextInterface.size () < nodes) {
+    m_nextInterface.resize (nodes, 1);
+  }
+  return AddLink (node1, node2, m_nextInterface[node1], m_nextInterface[node2], cost);
+}
+
+void AdjacencyIndex::Finalize () {
+  uint32_t nodes = 0;
+  for (const auto& link : m_links) {
+    nodes = std::max (nodes, std::max (link.node1, link.node2) + 1);
+  }
+
+  // Contagem dos graus seguida de soma de prefixos, como em um counting sort
+  m_offsets.assign (nodes + 1, 0);
+  for (const auto& link : m_links) {
+    ++m_offsets[link.node1 + 1];
+    ++m_offsets[link.node2 + 1];
+  }
+  for (uint32_t i = 0; i < nodes; ++i) {
+    m_offsets[i + 1] += m_offsets[i];
+  }
+
+  m_adjacencies.resize (2 * m_links.size ());
+  std::vector<uint32_t> next (m_offsets.begin (), m_offsets.end () - 1);
+  for (uint32_t i = 0; i < m_links.size (); ++i) {
+    const auto& link = m_links[i];
+    m_adjacencies[next[link.node1]++] = {link.node2, link.interface1, i};
+    m_adjacencies[next[link.node2]++] = {link.node1, link.interface2, i};
+  }
+
+  // Os enlaces paralelos mantêm a ordem de registro, então Find devolve o primeiro
+  for (uint32_t i = 0; i < nodes; ++i) {
+    std::stable_sort (m_adjacencies.begin () + m_offsets[i], m_adjacencies.begin () + m_offsets[i + 1],
+                      [] (const Adjacency& a, const Adjacency& b) { return a.neighbor < b.neighbor; });
+  }
+}
+
+const AdjacencyIndex::Adjacency* AdjacencyIndex::Find (uint32_t node, uint32_t neighbor) const {
+  if (node >= GetNNodes ()) {
+    return nullptr;
+  }
+  const Adjacency* begin = m_adjacencies.data () + m_offsets[node];
+  const Adjacency* end = m_adjacencies.data () + m_offsets[node + 1];
+  const Adjacency* it = std::lower_bound (begin, end, neighbor,
+                                          [] (const Adjacency& a, uint32_t n) { return a.neighbor < n; });
+  return it != end && it->neighbor == neighbor ? it : nullptr;
+}
+
+uint32_t AdjacencyIndex::GetInterface (uint32_t node, uint32_t neighbor) const {
+  const Adjacency* adjacency = Find (node, neighbor);
+  return adjacency == nullptr ? NOT_FOUND : adjacency->interface;
+}
+
+uint32_t AdjacencyIndex::GetLinkId (uint32_t node, uint32_t neighbor) const {
+  const Adjacency* adjacency = Find (node, neighbor);
+  return adjacency == nullptr ? NOT_FOUND : adjacency->link;
+}
+
+std::pair<const AdjacencyIndex::Adjacency*, const AdjacencyIndex::Adjacency*>
+AdjacencyIndex::GetNeighbors (uint32_t node) const {
+  if (node >= GetNNodes ()) {
+    return {nullptr, nullptr};
+  }
+  return {m_adjacencies.data () + m_offsets[node], m_adjacencies.data () + m_offsets[node + 1]};
+}
+
+} // namespace ns3
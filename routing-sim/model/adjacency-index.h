@@ -0,0 +1,112 @@
+#ifndef ADJACENCY_INDEX_H
+#define ADJACENCY_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * Índice de adjacência dos enlaces da simulação, por ID de nó (Node::GetId).
+ *
+ * Os enlaces são registrados com AddLink e, depois de Finalize, ficam em formato CSR: um vetor de
+ * deslocamentos por nó e um vetor contíguo de vizinhos ordenados, de forma que a interface de um
+ * nó para um vizinho é encontrada sem alocações nem contagem de referências, com uma busca binária
+ * entre os poucos vizinhos do nó.
+ *
+ * A consulta (nó, vizinho) custa O(log grau), e não O(1): um mapa direto por par exigiria uma
+ * tabela hash com uma entrada por adjacência, e com os graus das topologias simuladas (poucas
+ * unidades) a busca binária em memória contígua não é mais lenta do que o hash.
+ */
+class AdjacencyIndex {
+public:
+  static const uint32_t NOT_FOUND = UINT32_MAX;
+
+  /**
+   * Vizinho de um nó e o enlace que os liga.
+   */
+  struct Adjacency {
+    uint32_t neighbor;
+    uint32_t interface; //!< Interface IPv4 do nó para o vizinho
+    uint32_t link;
+  };
+
+  /**
+   * Enlace entre dois nós e as interfaces IPv4 de cada ponta.
+   */
+  struct Link {
+    uint32_t node1;
+    uint32_t node2;
+    uint32_t interface1;
+    uint32_t interface2;
+    uint8_t cost;
+  };
+
+  void Reserve (size_t links);
+
+  /**
+   * Registra um enlace. Só pode ser chamado antes de Finalize. As interfaces previstas pela outra
+   * sobrecarga passam a começar depois das interfaces informadas.
+   *
+   * @return ID do enlace, na ordem de registro.
+   */
+  uint32_t AddLink (uint32_t node1, uint32_t node2, uint32_t interface1, uint32_t interface2, uint8_t cost = 1);
+
+  /**
+   * Registra um enlace prevendo as interfaces: a interface 0 é o loopback e cada enlace registrado
+   * ocupa a próxima interface dos dois nós. A previsão só vale se os endereços dos enlaces forem
+   * atribuídos na mesma ordem do registro, o que permite consultar o índice antes de instalar a pilha.
+   *
+   * @return ID do enlace, na ordem de registro.
+   */
+  uint32_t AddLink (uint32_t node1, uint32_t node2, uint8_t cost = 1);
+
+  /**
+   * Monta o índice CSR a partir dos enlaces registrados.
+   */
+  void Finalize ();
+
+  /**
+   * @return Interface de node para neighbor (o primeiro enlace entre eles), ou NOT_FOUND.
+   */
+  uint32_t GetInterface (uint32_t node, uint32_t neighbor) const;
+
+  /**
+   * @return ID do primeiro enlace entre node e neighbor, ou NOT_FOUND.
+   */
+  uint32_t GetLinkId (uint32_t node, uint32_t neighbor) const;
+
+  const Link& GetLink (uint32_t link) const {
+    return m_links[link];
+  }
+
+  uint32_t GetNLinks () const {
+    return m_links.size ();
+  }
+
+  /**
+   * @return Número de nós, o maior ID registrado mais um.
+   */
+  uint32_t GetNNodes () const {
+    return m_offsets.empty () ? 0 : m_offsets.size () - 1;
+  }
+
+  /**
+   * Vizinhos de um nó, ordenados por ID, no intervalo [first, second).
+   */
+  std::pair<const Adjacency*, const Adjacency*> GetNeighbors (uint32_t node) const;
+
+private:
+  const Adjacency* Find (uint32_t node, uint32_t neighbor) const;
+
+  std::vector<Link> m_links;
+  std::vector<uint32_t> m_nextInterface; //!< Próxima interface prevista de cada nó
+  std::vector<uint32_t> m_offsets;       //!< Início dos vizinhos de cada nó em m_adjacencies
+  std::vector<Adjacency> m_adjacencies;
+};
+
+} // namespace ns3
+
+#endif /* ADJACENCY_INDEX_H */
@@ -0,0 +1,35 @@
+#include "buffered-writer.h"
+
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("BufferedWriter");
+
+BufferedWriter::BufferedWriter (const std::string& fileName, size_t bufferSize, bool binary)
+  : m_file (fileName, binary ? std::ios::out | std::ios::binary : std::ios::out),
+    m_bufferSize (bufferSize) {
+  if (!m_file.is_open ()) {
+    NS_LOG_ERROR("Não foi possível abrir o arquivo " << fileName);
+  }
+  m_buffer.reserve (m_bufferSize);
+}
+
+BufferedWriter::~BufferedWriter () {
+  Flush ();
+}
+
+void BufferedWriter::AppendAddress (uint32_t address) {
+  AppendFormat ("%u.%u.%u.%u", address >> 24, (address >> 16) & 0xff, (address >> 8) & 0xff, address & 0xff);
+}
+
+void BufferedWriter::Flush () {
+  if (m_buffer.empty ()) {
+    return;
+  }
+  m_file.write (m_buffer.data (), m_buffer.size ());
+  m_file.flush ();
+  m_buffer.clear ();
+}
+
+} // namespace ns3
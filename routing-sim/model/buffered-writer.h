@@ -0,0 +1,101 @@
+#ifndef BUFFERED_WRITER_H
+#define BUFFERED_WRITER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+namespace ns3 {
+
+/**
+ * Arquivo de saída com um buffer próprio: o texto (ou os bytes) é acumulado em memória e
+ * gravado com uma única escrita sempre que o buffer atinge bufferSize, evitando a formatação
+ * e a sincronização do iostream a cada registro.
+ */
+class BufferedWriter {
+public:
+  /**
+   * @param binary Abre o arquivo em modo binário.
+   */
+  BufferedWriter (const std::string& fileName, size_t bufferSize = 65536, bool binary = false);
+  ~BufferedWriter ();
+
+  BufferedWriter (const BufferedWriter&) = delete;
+  BufferedWriter& operator= (const BufferedWriter&) = delete;
+
+  bool IsOpen () const {
+    return m_file.is_open ();
+  }
+
+  void Append (std::string_view text) {
+    m_buffer.append (text.data (), text.size ());
+    FlushIfFull ();
+  }
+
+  void Append (char c) {
+    m_buffer += c;
+    FlushIfFull ();
+  }
+
+  /**
+   * Acrescenta o texto formatado com snprintf. Textos de até 63 caracteres são formatados em um
+   * buffer na pilha; os maiores são formatados uma segunda vez, diretamente no fim do buffer.
+   */
+  template <typename... Args>
+  void AppendFormat (const char* format, Args... args) {
+    char text[64];
+    int n = std::snprintf (text, sizeof (text), format, args...);
+    if (n < 0) {
+      return;
+    }
+    if (static_cast<size_t> (n) < sizeof (text)) {
+      m_buffer.append (text, n);
+    } else {
+      const size_t size = m_buffer.size ();
+      m_buffer.resize (size + n + 1);
+      std::snprintf (&m_buffer[size], n + 1, format, args...);
+      m_buffer.resize (size + n);
+    }
+    FlushIfFull ();
+  }
+
+  /**
+   * Acrescenta um endereço IPv4 em notação decimal.
+   */
+  void AppendAddress (uint32_t address);
+
+  /**
+   * Acrescenta os bytes de um valor, na ordem da máquina.
+   */
+  template <typename T>
+  void AppendBinary (T value) {
+    char bytes[sizeof (T)];
+    std::memcpy (bytes, &value, sizeof (T));
+    m_buffer.append (bytes, sizeof (T));
+    FlushIfFull ();
+  }
+
+  /**
+   * Grava o conteúdo do buffer no arquivo.
+   */
+  void Flush ();
+
+private:
+  void FlushIfFull () {
+    if (m_buffer.size () >= m_bufferSize) {
+      Flush ();
+    }
+  }
+
+  std::ofstream m_file;
+  size_t m_bufferSize;
+  std::string m_buffer;
+};
+
+} // namespace ns3
+
+#endif /* BUFFERED_WRITER_H */
@@ -0,0 +1,105 @@
+#include "control-overhead.h"
+#include "buffered-writer.h"
+#include "packet-capture.h"
+
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/names.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace ns3 {
+
+/**
+ * Bytes copiados do pacote para a classificação (cabeçalho IPv4 com opções e portas UDP).
+ */
+static const uint32_t HEADER_SIZE = 60 + 4;
+
+void ControlOverhead::Install (const NodeContainer& nodes) {
+  m_nodes.resize (m_nodes.size () + nodes.GetN ());
+  for (uint32_t i = 0; i < nodes.GetN (); ++i) {
+    Ptr<Node> node = nodes.Get (i);
+    std::string name = Names::FindName (node);
+    m_names.push_back (name.empty () ? std::to_string (node->GetId ()) : name);
+
+    m_sinks.push_back (std::unique_ptr<Sink> (new Sink {this, static_cast<uint32_t> (m_names.size () - 1)}));
+    Ptr<Ipv4L3Protocol> ipv4 = node->GetObject<Ipv4L3Protocol> ();
+    ipv4->TraceConnectWithoutContext ("Tx", MakeBoundCallback (&ControlOverhead::Transmitted, m_sinks.back ().get ()));
+    ipv4->TraceConnectWithoutContext ("Rx", MakeBoundCallback (&ControlOverhead::Received, m_sinks.back ().get ()));
+  }
+}
+
+bool ControlOverhead::IsControl (Ptr<const Packet> packet) {
+  uint8_t bytes[HEADER_SIZE];
+  uint32_t size = packet->CopyData (bytes, HEADER_SIZE);
+  return ClassifyIpv4Packet (bytes, size, 0) == CAPTURE_ROUTING;
+}
+
+void ControlOverhead::Transmitted (Sink* sink, Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface) {
+  if (!IsControl (packet)) {
+    return;
+  }
+  const uint32_t size = packet->GetSize ();
+  ControlOverhead* overhead = sink->overhead;
+  for (Counters* counters : {&overhead->m_nodes[sink->node], &overhead->m_current, &overhead->m_total}) {
+    ++counters->txPackets;
+    counters->txBytes += size;
+  }
+}
+
+void ControlOverhead::Received (Sink* sink, Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface) {
+  if (!IsControl (packet)) {
+    return;
+  }
+  const uint32_t size = packet->GetSize ();
+  ControlOverhead* overhead = sink->overhead;
+  for (Counters* counters : {&overhead->m_nodes[sink->node], &overhead->m_current, &overhead->m_total}) {
+    ++counters->rxPackets;
+    counters->rxBytes += size;
+  }
+}
+
+void ControlOverhead::Advance () {
+  const Time now = Simulator::Now ();
+  m_windows.push_back ({m_start, now, m_current});
+  m_current = Counters ();
+  if (m_windowOffsets.empty ()) {
+    m_windowOffsets.push_back (0);
+  }
+  m_nodeWindows.insert (m_nodeWindows.end (), m_nodes.begin (), m_nodes.end ());
+  m_windowOffsets.push_back (m_nodeWindows.size ());
+  std::fill (m_nodes.begin (), m_nodes.end (), Counters ());
+  m_start = now;
+}
+
+void ControlOverhead::Write (const std::string& fileName) const {
+  BufferedWriter writer (fileName);
+  writer.Append ("start,end,node,tx_packets,tx_bytes,rx_packets,rx_bytes\n");
+  for (size_t w = 0; w < m_windows.size (); ++w) {
+    const size_t first = m_windowOffsets[w];
+    for (size_t i = 0; first + i < m_windowOffsets[w + 1]; ++i) {
+      const Counters& counters = m_nodeWindows[first + i];
+      if (counters.txPackets == 0 && counters.rxPackets == 0) {
+        continue;
+      }
+      writer.AppendFormat ("%.9g,%.9g,", m_windows[w].start.GetSeconds (), m_windows[w].end.GetSeconds ());
+      writer.Append (m_names[i]);
+      writer.AppendFormat (",%llu,%llu", static_cast<unsigned long long> (counters.txPackets),
+                           static_cast<unsigned long long> (counters.txBytes));
+      writer.AppendFormat (",%llu,%llu\n", static_cast<unsigned long long> (counters.rxPackets),
+                           static_cast<unsigned long long> (counters.rxBytes));
+    }
+  }
+}
+
+void PrintControlOverhead (const std::vector<ControlOverhead::Window>& windows) {
+  for (const auto& window : windows) {
+    const ControlOverhead::Counters& total = window.total;
+    std::cout << "Fase de " << window.start.GetSeconds () << " s a " << window.end.GetSeconds () << " s: "
+              << total.txPackets << " pacotes enviados (" << total.txBytes << " bytes), "
+              << total.rxPackets << " recebidos (" << total.rxBytes << " bytes)\n";
+  }
+}
+
+} // namespace ns3
@@ -0,0 +1,108 @@
+#ifndef CONTROL_OVERHEAD_H
+#define CONTROL_OVERHEAD_H
+
+#include "ns3/ipv4.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/packet.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * Contabiliza o tráfego de controle dos protocolos de roteamento (RIP na porta UDP 520 e OLSR na
+ * 698) por nó e por janela de tempo, sem precisar capturar pacotes.
+ *
+ * Os pacotes são contados nos traces Tx e Rx do Ipv4L3Protocol de cada nó, que incluem o
+ * cabeçalho IPv4; os bytes contados são os do pacote IP. Os contadores da janela atual de cada nó
+ * ficam em um vetor indexado pela ordem de instalação, e os da rede em um único registro, então
+ * cada pacote custa só a leitura dos cabeçalhos. Ao encerrar uma janela, os contadores dos nós são
+ * copiados para um vetor contíguo com um bloco por janela.
+ */
+class ControlOverhead : public Object {
+public:
+  /**
+   * Pacotes e bytes de controle enviados e recebidos.
+   */
+  struct Counters {
+    uint64_t txPackets = 0;
+    uint64_t txBytes = 0;
+    uint64_t rxPackets = 0;
+    uint64_t rxBytes = 0;
+  };
+
+  /**
+   * Janela encerrada, com os contadores somados de todos os nós.
+   */
+  struct Window {
+    Time start;
+    Time end;
+    Counters total;
+  };
+
+  /**
+   * Passa a contar o tráfego de controle enviado e recebido pelos nós.
+   */
+  void Install (const NodeContainer& nodes);
+
+  /**
+   * Encerra a janela atual.
+   */
+  void Advance ();
+
+  /**
+   * @return Janelas encerradas, em ordem.
+   */
+  const std::vector<Window>& GetWindows () const {
+    return m_windows;
+  }
+
+  /**
+   * @return Contadores de toda a simulação, somados de todos os nós.
+   */
+  const Counters& GetTotal () const {
+    return m_total;
+  }
+
+  /**
+   * Grava os contadores de cada nó em cada janela encerrada em um arquivo CSV: start, end, node,
+   * tx_packets, tx_bytes, rx_packets e rx_bytes. Nós sem tráfego de controle na janela são omitidos.
+   */
+  void Write (const std::string& fileName) const;
+
+private:
+  /**
+   * Nó ao qual o trace está ligado.
+   */
+  struct Sink {
+    ControlOverhead* overhead;
+    uint32_t node;
+  };
+
+  static void Transmitted (Sink* sink, Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface);
+  static void Received (Sink* sink, Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface);
+  static bool IsControl (Ptr<const Packet> packet);
+
+  std::vector<std::unique_ptr<Sink>> m_sinks;
+  std::vector<std::string> m_names;
+  std::vector<Counters> m_nodes;        //!< Contadores de cada nó na janela atual
+  std::vector<Counters> m_nodeWindows;  //!< Contadores de cada nó nas janelas encerradas, em blocos
+  std::vector<size_t> m_windowOffsets;  //!< Início do bloco de cada janela em m_nodeWindows, mais o fim
+  Counters m_current;
+  Counters m_total;
+  Time m_start;
+  std::vector<Window> m_windows;
+};
+
+/**
+ * Imprime o tráfego de controle de cada janela.
+ */
+void PrintControlOverhead (const std::vector<ControlOverhead::Window>& windows);
+
+} // namespace ns3
+
+#endif /* CONTROL_OVERHEAD_H */
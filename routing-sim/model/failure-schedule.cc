@@ -0,0 +1,144 @@
+#include "failure-schedule.h"
+
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+
+namespace ns3 {
+
+FailureSchedule::FailureSchedule (const AdjacencyIndex& adjacency, Time stop)
+  : m_adjacency (adjacency),
+    m_stop (stop),
+    m_links (adjacency.GetNLinks ()),
+    m_random (CreateObject<ExponentialRandomVariable> ()) {
+  m_random->SetStream (RANDOM_STREAM);
+}
+
+void FailureSchedule::AddLinkFailure (uint32_t link, Time down, Time up) {
+  AddFailure (FailureTarget::LINK, link, down, up);
+}
+
+void FailureSchedule::Add (const FailureDescription& failure) {
+  NS_ASSERT_MSG (failure.target != FailureTarget::ALL_LINKS, "Falhas programadas afetam um enlace ou um nó");
+  const Time duration = failure.up - failure.down;
+  Time down = failure.down;
+  for (uint32_t i = 0; i < failure.repeat && down < m_stop; ++i) {
+    AddFailure (failure.target, failure.element, down, down + duration);
+    down += duration + failure.interval;
+  }
+}
+
+void FailureSchedule::AddRandom (const RandomFailureDescription& failure) {
+  NS_ASSERT_MSG (failure.mtbf > Time (0) && failure.mttr > Time (0), "MTBF e MTTR devem ser positivos");
+  if (failure.target != FailureTarget::ALL_LINKS) {
+    AddRandomFailures (failure.target, failure.element, failure);
+    return;
+  }
+  for (uint32_t link = 0; link < m_links.size (); ++link) {
+    AddRandomFailures (FailureTarget::LINK, link, failure);
+  }
+}
+
+void FailureSchedule::AddRandomFailures (FailureTarget target, uint32_t element,
+                                         const RandomFailureDescription& failure) {
+  // Um reparo sorteado depois do fim da janela ainda é aplicado, para o elemento não ficar caído
+  const Time end = std::min (failure.stop, m_stop);
+  Time down = failure.start;
+  while (true) {
+    down += Seconds (m_random->GetValue (failure.mtbf.GetSeconds (), 0));
+    if (down >= end) {
+      break;
+    }
+    Time up = down + Seconds (m_random->GetValue (failure.mttr.GetSeconds (), 0));
+    AddFailure (target, element, down, up);
+    down = up;
+  }
+}
+
+void FailureSchedule::AddFailure (FailureTarget target, uint32_t element, Time down, Time up) {
+  if (down >= m_stop) {
+    return;
+  }
+  auto addLink = [&] (uint32_t link) {
+    m_events.push_back ({down, link, false});
+    if (up < m_stop) {
+      m_events.push_back ({up, link, true});
+    }
+  };
+  if (target == FailureTarget::LINK) {
+    addLink (element);
+  } else {
+    auto neighbors = m_adjacency.GetNeighbors (element);
+    for (const auto* adjacency = neighbors.first; adjacency != neighbors.second; ++adjacency) {
+      addLink (adjacency->link);
+    }
+  }
+}
+
+void FailureSchedule::Start () {
+  std::sort (m_events.begin (), m_events.end (), [] (const Event& a, const Event& b) {
+    return a.time < b.time || (a.time == b.time && !a.up && b.up);
+  });
+  for (const auto& event : m_events) {
+    Resolve (event.link);
+  }
+
+  size_t first = 0;
+  while (first < m_events.size ()) {
+    size_t last = first + 1;
+    while (last < m_events.size () && m_events[last].time == m_events[first].time) {
+      ++last;
+    }
+    Simulator::Schedule (m_events[first].time - Simulator::Now (), &FailureSchedule::Apply, this, first, last);
+    first = last;
+  }
+}
+
+std::vector<Time> FailureSchedule::GetEventTimes () const {
+  std::vector<Time> times;
+  for (const auto& event : m_events) {
+    if (times.empty () || times.back () != event.time) {
+      times.push_back (event.time);
+    }
+  }
+  return times;
+}
+
+void FailureSchedule::Resolve (uint32_t link) {
+  LinkState& state = m_links[link];
+  if (state.ipv4[0] != nullptr) {
+    return;
+  }
+  const AdjacencyIndex::Link& description = m_adjacency.GetLink (link);
+  const uint32_t nodes[2] = {description.node1, description.node2};
+  const uint32_t interfaces[2] = {description.interface1, description.interface2};
+  for (uint32_t i = 0; i < 2; ++i) {
+    state.ipv4[i] = NodeList::GetNode (nodes[i])->GetObject<Ipv4> ();
+    state.interface[i] = interfaces[i];
+  }
+}
+
+void FailureSchedule::Apply (size_t first, size_t last) {
+  for (size_t i = first; i < last; ++i) {
+    const Event& event = m_events[i];
+    LinkState& state = m_links[event.link];
+    // Só a primeira queda e o último retorno mudam o estado das interfaces
+    if (!event.up) {
+      if (state.downCount++ > 0) {
+        continue;
+      }
+    } else if (state.downCount == 0 || --state.downCount > 0) {
+      continue;
+    }
+    for (uint32_t j = 0; j < 2; ++j) {
+      if (event.up) {
+        state.ipv4[j]->SetUp (state.interface[j]);
+      } else {
+        state.ipv4[j]->SetDown (state.interface[j]);
+      }
+    }
+  }
+}
+
+} // namespace ns3
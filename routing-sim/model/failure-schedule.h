@@ -0,0 +1,122 @@
+#ifndef FAILURE_SCHEDULE_H
+#define FAILURE_SCHEDULE_H
+
+#include "ns3/adjacency-index.h"
+#include "ns3/ipv4.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/topology-description.h"
+
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * Motor de falhas: expande falhas de enlaces e de nós, com flapping ou aleatórias, em uma lista de
+ * quedas e retornos por enlace e as aplica às interfaces IPv4 durante a simulação.
+ *
+ * Os eventos são ordenados uma vez em Start, que agenda um único evento do simulador por instante
+ * distinto; cada um aplica a faixa contígua de eventos do seu instante. As interfaces e os objetos
+ * Ipv4 das pontas de cada enlace são obtidos do AdjacencyIndex em Start, e não a cada evento.
+ *
+ * Cada enlace tem um contador de quedas: falhas sobrepostas (ex.: a queda de um enlace e a de um
+ * dos seus nós) só desabilitam as interfaces na primeira queda e só as habilitam de novo quando
+ * todas retornaram. No mesmo instante, as quedas são aplicadas antes dos retornos.
+ */
+class FailureSchedule : public Object {
+public:
+  /**
+   * Queda ou retorno de um enlace.
+   */
+  struct Event {
+    Time time;
+    uint32_t link;
+    bool up;
+  };
+
+  /**
+   * Sub-stream do gerador usado nas falhas aleatórias. É fixo para que todos os processos da
+   * simulação distribuída sorteiem os mesmos instantes, independentemente da ordem de criação das
+   * demais variáveis aleatórias; a execução é escolhida com --RngRun.
+   */
+  static const int64_t RANDOM_STREAM = 1 << 20;
+
+  /**
+   * @param adjacency Índice dos enlaces, que deve existir até Start. Os enlaces são os IDs do
+   *        índice e os nós são IDs do ns-3 (Node::GetId).
+   * @param stop Fim da simulação; eventos a partir desse instante são descartados.
+   */
+  FailureSchedule (const AdjacencyIndex& adjacency, Time stop);
+
+  /**
+   * Adiciona a queda de um enlace em down e o retorno em up.
+   */
+  void AddLinkFailure (uint32_t link, Time down, Time up);
+
+  /**
+   * Adiciona uma falha programada. O elemento é um ID do índice (enlace ou nó), não da descrição.
+   */
+  void Add (const FailureDescription& failure);
+
+  /**
+   * Sorteia as falhas aleatórias até o fim da simulação. Com ALL_LINKS, cada enlace tem o seu
+   * próprio processo de falhas; com NODE, todos os enlaces do nó caem juntos.
+   */
+  void AddRandom (const RandomFailureDescription& failure);
+
+  /**
+   * Ordena os eventos e os agenda no simulador. Deve ser chamada uma vez, antes da simulação e
+   * antes de agendar outros eventos que devam ocorrer depois das falhas no mesmo instante.
+   */
+  void Start ();
+
+  /**
+   * @return Instantes distintos dos eventos, em ordem crescente. Só é válido depois de Start.
+   */
+  std::vector<Time> GetEventTimes () const;
+
+  const std::vector<Event>& GetEvents () const {
+    return m_events;
+  }
+
+  /**
+   * @return Número de falhas ativas no enlace (zero se está habilitado).
+   */
+  uint32_t GetDownCount (uint32_t link) const {
+    return m_links[link].downCount;
+  }
+
+private:
+  /**
+   * Pontas de um enlace, obtidas em Start.
+   */
+  struct LinkState {
+    Ptr<Ipv4> ipv4[2];
+    uint32_t interface[2];
+    uint32_t downCount;
+  };
+
+  /**
+   * Adiciona a queda e o retorno de um enlace ou de todos os enlaces de um nó.
+   */
+  void AddFailure (FailureTarget target, uint32_t element, Time down, Time up);
+
+  /**
+   * Sorteia as quedas e retornos de um enlace ou nó entre start e stop.
+   */
+  void AddRandomFailures (FailureTarget target, uint32_t element, const RandomFailureDescription& failure);
+
+  void Resolve (uint32_t link);
+  void Apply (size_t first, size_t last);
+
+  const AdjacencyIndex& m_adjacency;
+  Time m_stop;
+  std::vector<Event> m_events;
+  std::vector<LinkState> m_links;
+  Ptr<ExponentialRandomVariable> m_random;
+};
+
+} // namespace ns3
+
+#endif /* FAILURE_SCHEDULE_H */
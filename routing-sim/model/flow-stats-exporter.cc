@@ -0,0 +1,153 @@
+#include "flow-stats-exporter.h"
+
+#include "ns3/simulator.h"
+
+namespace ns3 {
+
+/**
+ * Versão do formato binário.
+ */
+static const uint32_t BINARY_VERSION = 1;
+
+bool ParseFlowExportFormat (const std::string& name, FlowExportFormat& format) {
+  if (name == "csv") {
+    format = FlowExportFormat::CSV;
+  } else if (name == "jsonl") {
+    format = FlowExportFormat::JSON_LINES;
+  } else if (name == "binary") {
+    format = FlowExportFormat::BINARY;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+const char* GetFlowExportExtension (FlowExportFormat format) {
+  switch (format) {
+    case FlowExportFormat::CSV:
+      return ".csv";
+    case FlowExportFormat::JSON_LINES:
+      return ".jsonl";
+    default:
+      return ".bin";
+  }
+}
+
+FlowStatsExporter::FlowStatsExporter (Ptr<FlowMonitor> monitor, Ptr<FlowClassifier> classifier,
+                                      const std::string& fileName, FlowExportFormat format)
+  : m_monitor (monitor),
+    m_classifier (DynamicCast<Ipv4FlowClassifier> (classifier)),
+    m_writer (fileName, 65536, format == FlowExportFormat::BINARY),
+    m_format (format),
+    m_lastExport (Time (-1)) {
+  if (m_format == FlowExportFormat::CSV) {
+    m_writer.Append ("time,flow,flows,source,destination,protocol,source_port,destination_port,"
+                     "tx_packets,rx_packets,lost_packets,tx_bytes,rx_bytes,delay_sum,jitter_sum\n");
+  } else if (m_format == FlowExportFormat::BINARY) {
+    m_writer.Append ("RSFS");
+    m_writer.AppendBinary (BINARY_VERSION);
+  }
+}
+
+void FlowStatsExporter::Start (Time interval) {
+  m_interval = interval;
+  m_event.Cancel ();
+  if (m_interval.IsStrictlyPositive ()) {
+    m_event = Simulator::Schedule (m_interval, &FlowStatsExporter::ExportPeriodically, this);
+  }
+}
+
+void FlowStatsExporter::Stop () {
+  m_event.Cancel ();
+  if (m_lastExport != Simulator::Now ()) {
+    Export ();
+  }
+  m_writer.Flush ();
+}
+
+void FlowStatsExporter::ExportPeriodically () {
+  Export ();
+  m_event = Simulator::Schedule (m_interval, &FlowStatsExporter::ExportPeriodically, this);
+}
+
+void FlowStatsExporter::Export () {
+  m_lastExport = Simulator::Now ();
+  m_monitor->CheckForLostPackets ();
+
+  FlowSummary total;
+  for (const auto& stat : m_monitor->GetFlowStats ()) {
+    FlowSummary flow;
+    flow.Add (stat.second);
+    total.Add (stat.second);
+    if (m_classifier != nullptr) {
+      // Os FlowIds são sequenciais: só os fluxos novos são procurados no classificador
+      if (stat.first >= m_tuples.size ()) {
+        m_tuples.resize (stat.first + 1);
+        m_tuples[stat.first] = m_classifier->FindFlow (stat.first);
+      }
+      WriteRecord (stat.first, &m_tuples[stat.first], flow);
+    } else {
+      WriteRecord (stat.first, nullptr, flow);
+    }
+  }
+  WriteRecord (0, nullptr, total);
+}
+
+void FlowStatsExporter::WriteRecord (FlowId flow, const Ipv4FlowClassifier::FiveTuple* tuple,
+                                     const FlowSummary& summary) {
+  const double time = m_lastExport.GetSeconds ();
+  const unsigned long long counters[] = {summary.txPackets, summary.rxPackets, summary.lostPackets,
+                                         summary.txBytes, summary.rxBytes};
+
+  if (m_format == FlowExportFormat::BINARY) {
+    m_writer.AppendBinary (time);
+    m_writer.AppendBinary<uint32_t> (flow);
+    m_writer.AppendBinary<uint32_t> (summary.flows);
+    m_writer.AppendBinary<uint32_t> (tuple ? tuple->sourceAddress.Get () : 0);
+    m_writer.AppendBinary<uint32_t> (tuple ? tuple->destinationAddress.Get () : 0);
+    m_writer.AppendBinary<uint8_t> (tuple ? tuple->protocol : 0);
+    m_writer.AppendBinary<uint8_t> (0);
+    m_writer.AppendBinary<uint16_t> (tuple ? tuple->sourcePort : 0);
+    m_writer.AppendBinary<uint16_t> (tuple ? tuple->destinationPort : 0);
+    for (unsigned long long counter : counters) {
+      m_writer.AppendBinary<uint64_t> (counter);
+    }
+    m_writer.AppendBinary (summary.delaySum);
+    m_writer.AppendBinary (summary.jitterSum);
+    return;
+  }
+
+  if (m_format == FlowExportFormat::CSV) {
+    m_writer.AppendFormat ("%.9f,%u,%u,", time, flow, summary.flows);
+    if (tuple) {
+      m_writer.AppendAddress (tuple->sourceAddress.Get ());
+      m_writer.Append (',');
+      m_writer.AppendAddress (tuple->destinationAddress.Get ());
+      m_writer.AppendFormat (",%u,%u,%u", tuple->protocol, tuple->sourcePort, tuple->destinationPort);
+    } else {
+      m_writer.Append (",,,,");
+    }
+    for (unsigned long long counter : counters) {
+      m_writer.AppendFormat (",%llu", counter);
+    }
+    m_writer.AppendFormat (",%.9g,%.9g\n", summary.delaySum, summary.jitterSum);
+    return;
+  }
+
+  static const char* counterNames[] = {"tx_packets", "rx_packets", "lost_packets", "tx_bytes", "rx_bytes"};
+  m_writer.AppendFormat ("{\"time\":%.9f,\"flow\":%u,\"flows\":%u", time, flow, summary.flows);
+  if (tuple) {
+    m_writer.Append (",\"source\":\"");
+    m_writer.AppendAddress (tuple->sourceAddress.Get ());
+    m_writer.Append ("\",\"destination\":\"");
+    m_writer.AppendAddress (tuple->destinationAddress.Get ());
+    m_writer.AppendFormat ("\",\"protocol\":%u", tuple->protocol);
+    m_writer.AppendFormat (",\"source_port\":%u,\"destination_port\":%u", tuple->sourcePort, tuple->destinationPort);
+  }
+  for (size_t i = 0; i < 5; ++i) {
+    m_writer.AppendFormat (",\"%s\":%llu", counterNames[i], counters[i]);
+  }
+  m_writer.AppendFormat (",\"delay_sum\":%.9g,\"jitter_sum\":%.9g}\n", summary.delaySum, summary.jitterSum);
+}
+
+} // namespace ns3
@@ -0,0 +1,87 @@
+#ifndef FLOW_STATS_EXPORTER_H
+#define FLOW_STATS_EXPORTER_H
+
+#include "buffered-writer.h"
+#include "flow-stats.h"
+
+#include "ns3/event-id.h"
+#include "ns3/ipv4-flow-classifier.h"
+#include "ns3/object.h"
+
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * Formato do arquivo de estatísticas de fluxo.
+ */
+enum class FlowExportFormat : uint8_t {
+  CSV,        //!< Uma linha por registro, com cabeçalho
+  JSON_LINES, //!< Um objeto JSON por linha
+  BINARY      //!< Registros de tamanho fixo (ver FlowStatsExporter)
+};
+
+/**
+ * Converte o nome do formato (csv, jsonl ou binary).
+ */
+bool ParseFlowExportFormat (const std::string& name, FlowExportFormat& format);
+
+/**
+ * @return Extensão do arquivo do formato, com o ponto.
+ */
+const char* GetFlowExportExtension (FlowExportFormat format);
+
+/**
+ * Grava periodicamente as estatísticas de cada fluxo e o total de todos os fluxos, para que
+ * simulações longas possam ser analisadas sem interpretar a saída padrão.
+ *
+ * Cada exportação gera um registro por fluxo e um registro total (fluxo 0, sem endereços e portas),
+ * com os contadores acumulados desde o início da simulação: time, flow, flows, source, destination,
+ * protocol, source_port, destination_port, tx_packets, rx_packets, lost_packets, tx_bytes, rx_bytes,
+ * delay_sum e jitter_sum (em segundos).
+ *
+ * A quíntupla de cada fluxo é obtida do classificador uma única vez, na primeira exportação em que
+ * o fluxo aparece.
+ *
+ * O formato binário começa com "RSFS" e a versão (uint32) e segue com registros de 86 bytes na
+ * ordem de bytes da máquina, com os mesmos campos (em Python: struct "<dIIIIBxHHQQQQQdd" em x86).
+ */
+class FlowStatsExporter : public Object {
+public:
+  FlowStatsExporter (Ptr<FlowMonitor> monitor, Ptr<FlowClassifier> classifier, const std::string& fileName,
+                     FlowExportFormat format);
+
+  /**
+   * Exporta as estatísticas a cada interval, a partir de agora.
+   */
+  void Start (Time interval);
+
+  /**
+   * Encerra as exportações periódicas, exporta o estado atual se ainda não foi exportado e grava o buffer.
+   */
+  void Stop ();
+
+  /**
+   * Exporta as estatísticas de todos os fluxos no instante atual.
+   */
+  void Export ();
+
+private:
+  void ExportPeriodically ();
+  void WriteRecord (FlowId flow, const Ipv4FlowClassifier::FiveTuple* tuple, const FlowSummary& summary);
+
+  Ptr<FlowMonitor> m_monitor;
+  Ptr<Ipv4FlowClassifier> m_classifier;
+  BufferedWriter m_writer;
+  FlowExportFormat m_format;
+  Time m_interval;
+  Time m_lastExport;
+  EventId m_event;
+  std::vector<Ipv4FlowClassifier::FiveTuple> m_tuples; //!< Quíntuplas já classificadas, indexadas pelo FlowId
+
+};
+
+} // namespace ns3
+
+#endif /* FLOW_STATS_EXPORTER_H */
@@ -0,0 +1,183 @@
+#include "flow-stats.h"
+
+#include "ns3/ipv4.h"
+#include "ns3/ipv4-flow-classifier.h"
+#include "ns3/simulator.h"
+
+#include <iostream>
+
+namespace ns3 {
+
+void FlowSummary::Add (const FlowMonitor::FlowStats& stats) {
+  flows++;
+  txPackets += stats.txPackets;
+  rxPackets += stats.rxPackets;
+  lostPackets += stats.lostPackets;
+  txBytes += stats.txBytes;
+  rxBytes += stats.rxBytes;
+  delaySum += stats.delaySum.GetSeconds();
+  jitterSum += stats.rxPackets > 1 ? stats.jitterSum.GetSeconds() : 0;
+  jitterSamples += stats.rxPackets > 1 ? stats.rxPackets - 1 : 0;
+}
+
+FlowSummary& FlowSummary::operator+= (const FlowSummary& other) {
+  flows += other.flows;
+  txPackets += other.txPackets;
+  rxPackets += other.rxPackets;
+  lostPackets += other.lostPackets;
+  txBytes += other.txBytes;
+  rxBytes += other.rxBytes;
+  delaySum += other.delaySum;
+  jitterSum += other.jitterSum;
+  jitterSamples += other.jitterSamples;
+  return *this;
+}
+
+FlowSummary FlowSummary::operator- (const FlowSummary& previous) const {
+  FlowSummary difference = *this;
+  difference.txPackets -= previous.txPackets;
+  difference.rxPackets -= previous.rxPackets;
+  difference.lostPackets -= previous.lostPackets;
+  difference.txBytes -= previous.txBytes;
+  difference.rxBytes -= previous.rxBytes;
+  difference.delaySum -= previous.delaySum;
+  difference.jitterSum -= previous.jitterSum;
+  difference.jitterSamples -= previous.jitterSamples;
+  return difference;
+}
+
+double FlowSummary::GetLossRatio () const {
+  return txPackets ? static_cast<double>(lostPackets) / txPackets : 0;
+}
+
+double FlowSummary::GetAveragePacketSize () const {
+  return txPackets ? static_cast<double>(txBytes) / txPackets : 0;
+}
+
+double FlowSummary::GetThroughput (Time duration) const {
+  return duration.IsStrictlyPositive () ? rxBytes * 8.0 / duration.GetSeconds() / 1000 / 1000 : 0;
+}
+
+double FlowSummary::GetDelay () const {
+  return rxPackets ? delaySum / rxPackets : 0;
+}
+
+double FlowSummary::GetJitter () const {
+  return jitterSamples ? jitterSum / jitterSamples : 0;
+}
+
+FlowSummary GetTotalFlowSummary (Ptr<FlowMonitor> monitor) {
+  monitor->CheckForLostPackets();
+
+  FlowSummary total;
+  for (const auto& stat : monitor->GetFlowStats()) {
+    total.Add (stat.second);
+  }
+  return total;
+}
+
+FlowSelector::FlowSelector (Ptr<FlowClassifier> classifier, Ipv4Address source, Ipv4Address destination)
+  : m_classifier (DynamicCast<Ipv4FlowClassifier> (classifier)),
+    m_source (source),
+    m_destination (destination),
+    m_lastClassified (0) {
+}
+
+const std::vector<FlowId>& FlowSelector::Update (const FlowMonitor::FlowStatsContainer& stats) {
+  for (auto it = stats.upper_bound (m_lastClassified); it != stats.end (); ++it) {
+    Ipv4FlowClassifier::FiveTuple t = m_classifier->FindFlow (it->first);
+    if (t.sourceAddress == m_source && t.destinationAddress == m_destination) {
+      m_selected.push_back (it->first);
+    }
+    m_lastClassified = it->first;
+  }
+  return m_selected;
+}
+
+FlowStatsWindow::FlowStatsWindow (Ptr<FlowMonitor> monitor)
+  : m_monitor (monitor),
+    m_start (Simulator::Now ()) {
+}
+
+void FlowStatsWindow::Advance () {
+  m_monitor->CheckForLostPackets();
+
+  Window window;
+  window.start = m_start;
+  window.end = Simulator::Now ();
+  m_flows.clear ();
+  const FlowMonitor::FlowStatsContainer& stats = m_monitor->GetFlowStats();
+  if (m_selector != nullptr) {
+    for (FlowId flow : m_selector->Update (stats)) {
+      AddFlow (flow, stats.at (flow), window.total);
+    }
+  } else {
+    for (const auto& stat : stats) {
+      AddFlow (stat.first, stat.second, window.total);
+    }
+  }
+  m_windows.push_back (window);
+  m_start = window.end;
+}
+
+void FlowStatsWindow::AddFlow (FlowId flow, const FlowMonitor::FlowStats& stats, FlowSummary& total) {
+  if (flow >= m_previous.size ()) {
+    m_previous.resize (flow + 1);
+  }
+  FlowSummary current;
+  current.Add (stats);
+  FlowSummary difference = current - m_previous[flow];
+  m_previous[flow] = current;
+  m_flows.emplace_back (flow, difference);
+  total += difference;
+}
+
+void PrintFlowStats (Ptr<FlowStatsWindow> window) {
+  window->Advance ();
+  const FlowStatsWindow::Window& current = window->GetWindows ().back ();
+  Time duration = current.end - current.start;
+  std::cout << "\n=== Estatísticas de fluxo de " << current.start.GetSeconds() << " s a "
+            << current.end.GetSeconds() << " s ===\n";
+  Ptr<FlowSelector> selector = window->GetSelector ();
+
+  for (const auto& stat : window->GetFlows ()) {
+    const FlowSummary& flow = stat.second;
+    std::cout << "Fluxo " << stat.first;
+    if (selector != nullptr) {
+      std::cout << " (" << selector->GetSource () << " -> " << selector->GetDestination () << ")";
+    }
+    std::cout << "\n"
+              << "  Tx Packets: " << flow.txPackets << "\n"
+              << "  Rx Packets: " << flow.rxPackets << "\n"
+              << "  Lost Packets: " << flow.lostPackets << "\n"
+              << "  Packet Loss Ratio: " << flow.GetLossRatio () << "\n"
+              << "  Average Packet Size: " << flow.GetAveragePacketSize () << " bytes\n"
+              << "  Throughput: " << flow.GetThroughput (duration) << " Mbps\n"
+              << "  Delay: " << flow.GetDelay () << " s\n"
+              << "  Jitter: " << flow.GetJitter () << " s\n";
+  }
+}
+
+void PrintTotalFlowStats (Ptr<FlowStatsWindow> window) {
+  window->Advance ();
+  const FlowStatsWindow::Window& current = window->GetWindows ().back ();
+  const FlowSummary& total = current.total;
+  std::cout << "\n=== Estatísticas de fluxo totais de " << current.start.GetSeconds() << " s a "
+            << current.end.GetSeconds() << " s ===\n";
+
+  if (total.flows > 0) {
+    std::cout << "Total de Fluxos: " << total.flows << "\n"
+              << "Total Tx Packets: " << total.txPackets << "\n"
+              << "Total Rx Packets: " << total.rxPackets << "\n"
+              << "Total Lost Packets: " << total.lostPackets << "\n"
+              << "Packet Loss Ratio: " << total.GetLossRatio () << "\n"
+              << "Average Packet Size: " << total.GetAveragePacketSize () << " bytes\n"
+              << "Throughput: " << total.GetThroughput (current.end - current.start) << " Mbps\n"
+              << "Average Delay: " << total.GetDelay () << " s\n"
+              << "Average Jitter: " << total.GetJitter () << " s\n";
+  } else {
+    std::cout << "Nenhum fluxo detectado.\n";
+  }
+}
+
+} // namespace ns3
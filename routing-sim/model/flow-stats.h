@@ -0,0 +1,168 @@
+#ifndef FLOW_STATS_H
+#define FLOW_STATS_H
+
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-monitor-helper.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv4-flow-classifier.h"
+#include "ns3/node.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * Estatísticas acumuladas de um ou mais fluxos.
+ */
+struct FlowSummary {
+  uint32_t flows = 0;
+  uint64_t txPackets = 0;
+  uint64_t rxPackets = 0;
+  uint64_t lostPackets = 0;
+  uint64_t txBytes = 0;
+  uint64_t rxBytes = 0;
+  double delaySum = 0;
+  double jitterSum = 0;
+  uint64_t jitterSamples = 0; //!< Pacotes recebidos depois do primeiro de cada fluxo
+
+  void Add (const FlowMonitor::FlowStats& stats);
+
+  FlowSummary& operator+= (const FlowSummary& other);
+
+  /**
+   * @return Diferença entre os contadores e os de um instante anterior (previous), com o número
+   *         de fluxos deste resumo.
+   */
+  FlowSummary operator- (const FlowSummary& previous) const;
+
+  double GetLossRatio () const;
+  double GetAveragePacketSize () const;
+  /**
+   * @return Vazão em Mbps no período informado.
+   */
+  double GetThroughput (Time duration) const;
+  double GetDelay () const;
+  double GetJitter () const;
+};
+
+/**
+ * @return Estatísticas somadas de todos os fluxos do monitor.
+ */
+FlowSummary GetTotalFlowSummary (Ptr<FlowMonitor> monitor);
+
+/**
+ * Fluxos de interesse, de um endereço de origem para um de destino.
+ *
+ * Ipv4FlowClassifier::FindFlow percorre todos os fluxos a cada chamada, então cada FlowId é
+ * classificado uma única vez, na primeira atualização em que aparece no monitor, e os
+ * selecionados ficam guardados: o custo de cada atualização depende só dos fluxos novos.
+ */
+class FlowSelector : public Object {
+public:
+  FlowSelector (Ptr<FlowClassifier> classifier, Ipv4Address source, Ipv4Address destination);
+
+  /**
+   * Classifica os fluxos criados desde a última atualização.
+   * @return FlowIds dos fluxos selecionados, em ordem crescente.
+   */
+  const std::vector<FlowId>& Update (const FlowMonitor::FlowStatsContainer& stats);
+
+  Ipv4Address GetSource () const {
+    return m_source;
+  }
+
+  Ipv4Address GetDestination () const {
+    return m_destination;
+  }
+
+private:
+  Ptr<Ipv4FlowClassifier> m_classifier;
+  Ipv4Address m_source;
+  Ipv4Address m_destination;
+  FlowId m_lastClassified;
+  std::vector<FlowId> m_selected;
+};
+
+/**
+ * Estatísticas de fluxo em janelas de tempo consecutivas (por exemplo antes, durante e depois de
+ * uma falha), calculadas pela diferença entre os contadores do FlowMonitor no início e no fim de
+ * cada janela. Só os contadores do último limite de cada fluxo são guardados, além do total de
+ * cada janela encerrada.
+ *
+ * Os pacotes só são considerados perdidos pelo FlowMonitor depois de MaxPerHopDelay (10 s por
+ * padrão) sem chegar, então parte das perdas de uma janela aparece na janela seguinte.
+ */
+class FlowStatsWindow : public Object {
+public:
+  /**
+   * Janela encerrada.
+   */
+  struct Window {
+    Time start;
+    Time end;
+    FlowSummary total;
+  };
+
+  /**
+   * A primeira janela começa no instante da criação.
+   */
+  FlowStatsWindow (Ptr<FlowMonitor> monitor);
+
+  /**
+   * Restringe as janelas aos fluxos do seletor: só eles são consultados a cada limite.
+   */
+  void SetSelector (Ptr<FlowSelector> selector) {
+    m_selector = selector;
+  }
+
+  Ptr<FlowSelector> GetSelector () const {
+    return m_selector;
+  }
+
+  /**
+   * Encerra a janela atual no instante atual e inicia a próxima.
+   */
+  void Advance ();
+
+  /**
+   * @return Estatísticas de cada fluxo na última janela encerrada.
+   */
+  const std::vector<std::pair<FlowId, FlowSummary>>& GetFlows () const {
+    return m_flows;
+  }
+
+  /**
+   * @return Janelas encerradas, em ordem.
+   */
+  const std::vector<Window>& GetWindows () const {
+    return m_windows;
+  }
+
+private:
+  void AddFlow (FlowId flow, const FlowMonitor::FlowStats& stats, FlowSummary& total);
+
+  Ptr<FlowMonitor> m_monitor;
+  Ptr<FlowSelector> m_selector;
+  Time m_start;
+  std::vector<FlowSummary> m_previous; //!< Contadores no início da janela atual, indexados pelo FlowId
+  std::vector<std::pair<FlowId, FlowSummary>> m_flows;
+  std::vector<Window> m_windows;
+};
+
+/**
+ * Encerra a janela atual e imprime as estatísticas de cada fluxo nessa janela (os fluxos do
+ * seletor da janela, se houver).
+ */
+void PrintFlowStats (Ptr<FlowStatsWindow> window);
+
+/**
+ * Encerra a janela atual e imprime as estatísticas somadas de todos os fluxos nessa janela.
+ */
+void PrintTotalFlowStats (Ptr<FlowStatsWindow> window);
+
+} // namespace ns3
+
+#endif /* FLOW_STATS_H */
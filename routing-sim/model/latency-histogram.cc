@@ -0,0 +1,94 @@
+#include "latency-histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+
+/**
+ * Maior potência de dois (em nanossegundos) representada pelo histograma.
+ */
+static const uint32_t MAX_EXPONENT = 40;
+
+LatencyHistogram::LatencyHistogram (uint8_t precision)
+  : m_precision (precision),
+    m_counts ((MAX_EXPONENT - precision + 2) << precision, 0),
+    m_count (0),
+    m_sum (0),
+    m_min (0),
+    m_max (0) {
+}
+
+uint32_t LatencyHistogram::GetIndex (uint64_t value) const {
+  // Valores abaixo de 2^precision têm faixas de largura 1
+  if (value < (uint64_t (1) << m_precision)) {
+    return value;
+  }
+  uint32_t exponent = 63 - __builtin_clzll (value);
+  if (exponent > MAX_EXPONENT) {
+    return m_counts.size () - 1;
+  }
+  uint32_t shift = exponent - m_precision;
+  uint32_t subBucket = (value >> shift) & ((uint64_t (1) << m_precision) - 1);
+  return ((shift + 1) << m_precision) | subBucket;
+}
+
+int64_t LatencyHistogram::GetValue (uint32_t index) const {
+  if (index < (uint32_t (1) << m_precision)) {
+    return index;
+  }
+  uint32_t shift = (index >> m_precision) - 1;
+  uint64_t subBucket = index & ((uint32_t (1) << m_precision) - 1);
+  uint64_t lower = ((uint64_t (1) << m_precision) | subBucket) << shift;
+  return lower + ((uint64_t (1) << shift) >> 1);
+}
+
+void LatencyHistogram::Record (int64_t nanoseconds) {
+  nanoseconds = std::max<int64_t> (nanoseconds, 0);
+  ++m_counts[GetIndex (nanoseconds)];
+  m_min = m_count ? std::min (m_min, nanoseconds) : nanoseconds;
+  m_max = m_count ? std::max (m_max, nanoseconds) : nanoseconds;
+  m_sum += nanoseconds;
+  ++m_count;
+}
+
+void LatencyHistogram::Add (const LatencyHistogram& other) {
+  if (other.m_count == 0) {
+    return;
+  }
+  for (size_t i = 0; i < m_counts.size () && i < other.m_counts.size (); ++i) {
+    m_counts[i] += other.m_counts[i];
+  }
+  m_min = m_count ? std::min (m_min, other.m_min) : other.m_min;
+  m_max = m_count ? std::max (m_max, other.m_max) : other.m_max;
+  m_sum += other.m_sum;
+  m_count += other.m_count;
+}
+
+void LatencyHistogram::Reset () {
+  std::fill (m_counts.begin (), m_counts.end (), 0);
+  m_count = 0;
+  m_sum = 0;
+}
+
+double LatencyHistogram::GetMean () const {
+  return m_count ? m_sum / m_count : 0;
+}
+
+int64_t LatencyHistogram::GetPercentile (double quantile) const {
+  if (m_count == 0) {
+    return 0;
+  }
+  uint64_t rank = std::max<uint64_t> (1, std::ceil (quantile * m_count));
+  uint64_t cumulative = 0;
+  for (uint32_t i = 0; i < m_counts.size (); ++i) {
+    cumulative += m_counts[i];
+    if (cumulative >= rank) {
+      // O ponto médio da faixa pode passar dos extremos observados
+      return std::min (std::max (GetValue (i), m_min), m_max);
+    }
+  }
+  return m_max;
+}
+
+} // namespace ns3
@@ -0,0 +1,67 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <cstdint>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * Histograma de latências com faixas logarítmicas, no estilo do HdrHistogram.
+ *
+ * Cada potência de dois é dividida em 2^precision faixas iguais, então o erro relativo de um
+ * percentil é de no máximo 2^-precision (3% com o padrão de 5 bits). Os valores, em nanossegundos,
+ * vão até 2^40 ns (cerca de 18 minutos); valores maiores caem na última faixa. A memória é fixa
+ * (cerca de 9 KiB com o padrão) e cada inserção custa O(1).
+ */
+class LatencyHistogram {
+public:
+  explicit LatencyHistogram (uint8_t precision = 5);
+
+  void Record (int64_t nanoseconds);
+
+  /**
+   * Soma as contagens de outro histograma com a mesma precisão.
+   */
+  void Add (const LatencyHistogram& other);
+
+  void Reset ();
+
+  uint64_t GetCount () const {
+    return m_count;
+  }
+
+  /**
+   * @return Média exata dos valores, em nanossegundos.
+   */
+  double GetMean () const;
+
+  int64_t GetMin () const {
+    return m_count ? m_min : 0;
+  }
+
+  int64_t GetMax () const {
+    return m_count ? m_max : 0;
+  }
+
+  /**
+   * @param quantile Entre 0 e 1 (0.99 para o p99).
+   * @return Valor do percentil em nanossegundos (ponto médio da faixa), ou 0 sem valores.
+   */
+  int64_t GetPercentile (double quantile) const;
+
+private:
+  uint32_t GetIndex (uint64_t value) const;
+  int64_t GetValue (uint32_t index) const;
+
+  uint8_t m_precision;
+  std::vector<uint64_t> m_counts;
+  uint64_t m_count;
+  double m_sum;
+  int64_t m_min;
+  int64_t m_max;
+};
+
+} // namespace ns3
+
+#endif /* LATENCY_HISTOGRAM_H */
@@ -0,0 +1,96 @@
+#include "latency-monitor.h"
+
+#include "ns3/inet-socket-address.h"
+#include "ns3/seq-ts-header.h"
+#include "ns3/simulator.h"
+
+#include <iostream>
+
+namespace ns3 {
+
+LatencyMonitor::LatencyMonitor (const std::string& fileName)
+  : m_writer (fileName) {
+  m_writer.Append ("window_start,window_end,source,source_port,destination_port,packets,"
+                   "min,p50,p90,p99,p999,max,mean\n");
+}
+
+void LatencyMonitor::Install (ApplicationContainer servers) {
+  for (uint32_t i = 0; i < servers.GetN (); ++i) {
+    // O RxWithAddresses é disparado antes do UdpServer remover o SeqTsHeader
+    servers.Get (i)->TraceConnectWithoutContext ("RxWithAddresses", MakeCallback (&LatencyMonitor::Receive, this));
+  }
+}
+
+void LatencyMonitor::Receive (Ptr<const Packet> packet, const Address& from, const Address& local) {
+  if (!InetSocketAddress::IsMatchingType (from) || !InetSocketAddress::IsMatchingType (local)) {
+    return;
+  }
+  SeqTsHeader header;
+  packet->PeekHeader (header);
+  const int64_t latency = (Simulator::Now () - header.GetTs ()).GetNanoSeconds ();
+
+  InetSocketAddress source = InetSocketAddress::ConvertFrom (from);
+  uint16_t destinationPort = InetSocketAddress::ConvertFrom (local).GetPort ();
+  uint64_t key = (uint64_t (source.GetIpv4 ().Get ()) << 32) | (uint32_t (source.GetPort ()) << 16) | destinationPort;
+  auto it = m_flowIndex.find (key);
+  if (it == m_flowIndex.end ()) {
+    it = m_flowIndex.emplace (key, m_flows.size ()).first;
+    m_flows.push_back ({source.GetIpv4 ().Get (), source.GetPort (), destinationPort, LatencyHistogram ()});
+  }
+  m_flows[it->second].latency.Record (latency);
+  m_total.Record (latency);
+}
+
+void LatencyMonitor::Advance () {
+  const Time end = Simulator::Now ();
+  for (auto& flow : m_flows) {
+    if (flow.latency.GetCount () > 0) {
+      WriteRecord (&flow, flow.latency);
+      flow.latency.Reset ();
+    }
+  }
+  WriteRecord (nullptr, m_total);
+
+  m_windows.push_back ({m_start, end, m_total.GetCount (), NanoSeconds (m_total.GetPercentile (0.5)),
+                        NanoSeconds (m_total.GetPercentile (0.99)), NanoSeconds (m_total.GetPercentile (0.999)),
+                        NanoSeconds (m_total.GetMax ())});
+  m_total.Reset ();
+  m_start = end;
+}
+
+void LatencyMonitor::WriteRecord (const Flow* flow, const LatencyHistogram& latency) {
+  m_writer.AppendFormat ("%.9g,%.9g,", m_start.GetSeconds (), Simulator::Now ().GetSeconds ());
+  if (flow != nullptr) {
+    m_writer.AppendAddress (flow->source);
+    m_writer.AppendFormat (",%u,%u,", flow->sourcePort, flow->destinationPort);
+  } else {
+    m_writer.Append (",,,");
+  }
+  m_writer.AppendFormat ("%llu,", static_cast<unsigned long long> (latency.GetCount ()));
+  const double values[] = {double (latency.GetMin ()), double (latency.GetPercentile (0.5)),
+                           double (latency.GetPercentile (0.9)), double (latency.GetPercentile (0.99)),
+                           double (latency.GetPercentile (0.999)), double (latency.GetMax ()), latency.GetMean ()};
+  for (size_t i = 0; i < sizeof (values) / sizeof (values[0]); ++i) {
+    m_writer.AppendFormat (i == 0 ? "%.9g" : ",%.9g", values[i] * 1e-9);
+  }
+  m_writer.Append ('\n');
+}
+
+void PrintLatencyStats (Ptr<LatencyMonitor> monitor) {
+  monitor->Advance ();
+  const LatencyMonitor::Window& current = monitor->GetWindows ().back ();
+  std::cout << "\n=== Latência dos pacotes de " << current.start.GetSeconds() << " s a "
+            << current.end.GetSeconds() << " s ===\n";
+
+  if (current.packets > 0) {
+    std::cout << "Pacotes recebidos: " << current.packets << "\n"
+              << "p50: " << current.p50.GetSeconds () << " s\n"
+              << "p99: " << current.p99.GetSeconds () << " s\n"
+              << "p999: " << current.p999.GetSeconds () << " s\n"
+              << "Máxima: " << current.max.GetSeconds () << " s\n";
+  } else {
+    std::cout << "Nenhum pacote recebido.\n";
+  }
+}
+
+} // namespace ns3
@@ -0,0 +1,99 @@
+#ifndef LATENCY_MONITOR_H
+#define LATENCY_MONITOR_H
+
+#include "buffered-writer.h"
+#include "latency-histogram.h"
+
+#include "ns3/address.h"
+#include "ns3/application-container.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/packet.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * Mede a latência de cada pacote recebido pelos UdpServer e calcula os percentis de cauda
+ * (p50, p99, p999) por fluxo e por janela, que as médias do FlowMonitor escondem durante as quedas de enlace.
+ *
+ * A latência é o instante de recepção menos o timestamp do SeqTsHeader colocado pelo UdpClient.
+ * Cada fluxo (endereço e porta de origem, porta de destino) tem um LatencyHistogram, então a memória
+ * não depende do número de pacotes. A cada Advance, uma linha por fluxo e uma linha total (origem
+ * vazia) são gravadas no arquivo CSV: window_start, window_end, source, source_port,
+ * destination_port, packets, min, p50, p90, p99, p999, max e mean (em segundos).
+ */
+class LatencyMonitor : public Object {
+public:
+  /**
+   * Percentis de todos os fluxos em uma janela encerrada.
+   */
+  struct Window {
+    Time start;
+    Time end;
+    uint64_t packets;
+    Time p50;
+    Time p99;
+    Time p999;
+    Time max;
+  };
+
+  LatencyMonitor (const std::string& fileName);
+
+  /**
+   * Passa a medir os pacotes recebidos pelos UdpServer do contêiner.
+   */
+  void Install (ApplicationContainer servers);
+
+  /**
+   * Encerra a janela atual: grava os percentis de cada fluxo, guarda os totais e zera os histogramas.
+   */
+  void Advance ();
+
+  /**
+   * @return Janelas encerradas, em ordem.
+   */
+  const std::vector<Window>& GetWindows () const {
+    return m_windows;
+  }
+
+  /**
+   * Grava o buffer do arquivo.
+   */
+  void Flush () {
+    m_writer.Flush ();
+  }
+
+private:
+  /**
+   * Histograma de um fluxo na janela atual.
+   */
+  struct Flow {
+    uint32_t source;
+    uint16_t sourcePort;
+    uint16_t destinationPort;
+    LatencyHistogram latency;
+  };
+
+  void Receive (Ptr<const Packet> packet, const Address& from, const Address& local);
+  void WriteRecord (const Flow* flow, const LatencyHistogram& latency);
+
+  BufferedWriter m_writer;
+  Time m_start;
+  std::unordered_map<uint64_t, uint32_t> m_flowIndex; //!< Fluxo (origem, porta de origem e de destino) -> índice em m_flows
+  std::vector<Flow> m_flows;
+  LatencyHistogram m_total;
+  std::vector<Window> m_windows;
+};
+
+/**
+ * Encerra a janela atual e imprime os percentis de latência de todos os fluxos nessa janela.
+ */
+void PrintLatencyStats (Ptr<LatencyMonitor> monitor);
+
+} // namespace ns3
+
+#endif /* LATENCY_MONITOR_H */
@@ -0,0 +1,117 @@
+#include "loss-timeline.h"
+
+#include "ns3/seq-ts-header.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace ns3 {
+
+LossTimeline::LossTimeline (Time resolution, uint32_t capacity, const std::string& fileName)
+  : m_resolution (resolution),
+    m_bins (std::max<uint32_t> (capacity, 1), Bin {-1, 0, 0}),
+    m_oldest (0) {
+  if (!fileName.empty ()) {
+    m_writer = std::make_unique<BufferedWriter> (fileName);
+    m_writer->Append ("time,sent,received,lost\n");
+  }
+}
+
+void LossTimeline::Install (ApplicationContainer clients, ApplicationContainer servers) {
+  for (uint32_t i = 0; i < clients.GetN (); ++i) {
+    clients.Get (i)->TraceConnectWithoutContext ("Tx", MakeCallback (&LossTimeline::Sent, this));
+  }
+  for (uint32_t i = 0; i < servers.GetN (); ++i) {
+    servers.Get (i)->TraceConnectWithoutContext ("RxWithAddresses", MakeCallback (&LossTimeline::Received, this));
+  }
+}
+
+void LossTimeline::AddEvent (Time event) {
+  Outage outage = {event, event, event, 0};
+  m_outages.insert (std::upper_bound (m_outages.begin (), m_outages.end (), outage,
+                                      [] (const Outage& a, const Outage& b) { return a.event < b.event; }),
+                    outage);
+}
+
+void LossTimeline::Sent (Ptr<const Packet> packet) {
+  const int64_t index = Simulator::Now ().GetTimeStep () / m_resolution.GetTimeStep ();
+  Bin& bin = m_bins[index % m_bins.size ()];
+  if (bin.index != index) {
+    // O intervalo novo ocupa a posição do mais antigo do buffer
+    Evict (index - m_bins.size () + 1);
+    bin = {index, 0, 0};
+  }
+  ++bin.sent;
+}
+
+void LossTimeline::Received (Ptr<const Packet> packet, const Address& from, const Address& local) {
+  SeqTsHeader header;
+  packet->PeekHeader (header);
+  const int64_t index = header.GetTs ().GetTimeStep () / m_resolution.GetTimeStep ();
+  Bin& bin = m_bins[index % m_bins.size ()];
+  if (bin.index == index) {
+    ++bin.received;
+  }
+}
+
+void LossTimeline::Evict (int64_t index) {
+  // Os intervalos guardados estão entre m_oldest e m_oldest + capacidade, e são encerrados em ordem
+  const int64_t last = std::min<int64_t> (index, m_oldest + m_bins.size ());
+  for (int64_t i = m_oldest; i < last; ++i) {
+    Bin& bin = m_bins[i % m_bins.size ()];
+    if (bin.index == i) {
+      Close (bin);
+      bin.index = -1;
+    }
+  }
+  m_oldest = std::max (m_oldest, index);
+}
+
+void LossTimeline::Close (const Bin& bin) {
+  const Time start = TimeStep (m_resolution.GetTimeStep () * bin.index);
+  const Time end = start + m_resolution;
+  const uint32_t lost = bin.sent - std::min (bin.received, bin.sent);
+  if (m_writer != nullptr) {
+    m_writer->AppendFormat ("%.9g,%u,%u,%u\n", start.GetSeconds (), bin.sent, bin.received, lost);
+  }
+  if (lost == 0) {
+    return;
+  }
+
+  // Último evento anterior ao fim do intervalo; as perdas antes do primeiro evento não são atribuídas
+  auto outage = std::lower_bound (m_outages.begin (), m_outages.end (), end,
+                                  [] (const Outage& o, const Time& t) { return o.event < t; });
+  if (outage == m_outages.begin ()) {
+    return;
+  }
+  --outage;
+  if (outage->lostPackets == 0) {
+    outage->start = std::max (start, outage->event);
+  }
+  outage->end = end;
+  outage->lostPackets += lost;
+}
+
+void LossTimeline::Finish () {
+  Evict (m_oldest + m_bins.size ());
+  if (m_writer != nullptr) {
+    m_writer->Flush ();
+  }
+}
+
+void PrintOutages (Ptr<LossTimeline> timeline) {
+  std::cout << "\nPerdas de pacotes após cada evento:\n";
+  for (const auto& outage : timeline->GetOutages ()) {
+    std::cout << "Evento em " << outage.event.GetSeconds () << " s: ";
+    if (outage.lostPackets > 0) {
+      std::cout << outage.lostPackets << " pacotes perdidos de " << outage.start.GetSeconds () << " s a "
+                << outage.end.GetSeconds () << " s (recuperação em " << outage.GetRecoveryTime ().GetSeconds ()
+                << " s)\n";
+    } else {
+      std::cout << "nenhum pacote perdido\n";
+    }
+  }
+}
+
+} // namespace ns3
@@ -0,0 +1,115 @@
+#ifndef LOSS_TIMELINE_H
+#define LOSS_TIMELINE_H
+
+#include "buffered-writer.h"
+
+#include "ns3/address.h"
+#include "ns3/application-container.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/packet.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * Linha do tempo das perdas de pacotes em intervalos de tamanho fixo, para saber exatamente quando
+ * os pacotes começaram e deixaram de ser perdidos em torno de cada queda ou retorno de enlace.
+ *
+ * Cada pacote é contado no intervalo em que foi enviado: os envios vêm do trace Tx dos UdpClient e
+ * as recepções, do timestamp do SeqTsHeader recebido pelos UdpServer. Os intervalos ficam em um
+ * buffer circular com capacidade fixa; um intervalo é encerrado quando sai do buffer, então pacotes
+ * com atraso maior que capacity * resolution são contados como perdidos.
+ *
+ * Os intervalos encerrados com envios são gravados no arquivo CSV (se houver): time, sent, received
+ * e lost. As perdas de cada intervalo são atribuídas ao último evento (ver AddEvent) anterior ao fim
+ * do intervalo, e formam a interrupção desse evento.
+ */
+class LossTimeline : public Object {
+public:
+  /**
+   * Perdas atribuídas a um evento.
+   */
+  struct Outage {
+    Time event;
+    Time start;           //!< Início do primeiro intervalo com perdas
+    Time end;             //!< Fim do último intervalo com perdas
+    uint64_t lostPackets;
+
+    /**
+     * @return Tempo entre o primeiro e o último intervalo com perdas (zero sem perdas).
+     */
+    Time GetDuration () const {
+      return end - start;
+    }
+
+    /**
+     * @return Tempo entre o evento e o fim das perdas (zero sem perdas).
+     */
+    Time GetRecoveryTime () const {
+      return lostPackets > 0 ? end - event : Time (0);
+    }
+  };
+
+  /**
+   * @param resolution Tamanho dos intervalos.
+   * @param capacity Número de intervalos no buffer circular.
+   * @param fileName Arquivo CSV da linha do tempo; vazio para não gravar.
+   */
+  LossTimeline (Time resolution, uint32_t capacity, const std::string& fileName = "");
+
+  /**
+   * Passa a contar os pacotes enviados pelos UdpClient e recebidos pelos UdpServer dos contêineres.
+   */
+  void Install (ApplicationContainer clients, ApplicationContainer servers);
+
+  /**
+   * Registra o instante de uma queda ou retorno de enlace. Os eventos devem ser registrados antes da simulação.
+   */
+  void AddEvent (Time event);
+
+  /**
+   * Encerra todos os intervalos do buffer e grava o arquivo. Deve ser chamada depois da simulação.
+   */
+  void Finish ();
+
+  /**
+   * @return Perdas de cada evento, na ordem dos instantes.
+   */
+  const std::vector<Outage>& GetOutages () const {
+    return m_outages;
+  }
+
+private:
+  /**
+   * Contadores de um intervalo; index é o número do intervalo desde o início da simulação (-1 se vazio).
+   */
+  struct Bin {
+    int64_t index;
+    uint32_t sent;
+    uint32_t received;
+  };
+
+  void Sent (Ptr<const Packet> packet);
+  void Received (Ptr<const Packet> packet, const Address& from, const Address& local);
+  void Evict (int64_t index);
+  void Close (const Bin& bin);
+
+  Time m_resolution;
+  std::vector<Bin> m_bins;
+  int64_t m_oldest; //!< Intervalos anteriores a este já foram encerrados
+  std::unique_ptr<BufferedWriter> m_writer;
+  std::vector<Outage> m_outages;
+};
+
+/**
+ * Imprime as perdas atribuídas a cada evento da linha do tempo.
+ */
+void PrintOutages (Ptr<LossTimeline> timeline);
+
+} // namespace ns3
+
+#endif /* LOSS_TIMELINE_H */
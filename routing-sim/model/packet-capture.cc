@@ -0,0 +1,178 @@
+#include "packet-capture.h"
+
+#include "ns3/names.h"
+#include "ns3/simulator.h"
+#include "ns3/trace-helper.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace ns3 {
+
+/**
+ * Portas UDP dos protocolos de roteamento.
+ */
+static const uint16_t RIP_PORT = 520;
+static const uint16_t OLSR_PORT = 698;
+
+/**
+ * Bytes copiados do pacote para a classificação quando o snapLen é menor (cabeçalhos Ethernet, IPv4 com opções e UDP).
+ */
+static const uint32_t CLASSIFY_SIZE = 14 + 60 + 8;
+
+/**
+ * Tipos dos blocos do pcapng.
+ */
+static const uint32_t SECTION_HEADER_BLOCK = 0x0a0d0d0a;
+static const uint32_t INTERFACE_DESCRIPTION_BLOCK = 1;
+static const uint32_t ENHANCED_PACKET_BLOCK = 6;
+
+uint8_t ClassifyIpv4Packet (const uint8_t* bytes, uint32_t size, uint16_t applicationPort) {
+  if (size < 20) {
+    return CAPTURE_OTHER;
+  }
+  const uint32_t headerSize = (bytes[0] & 0x0f) * 4;
+  const bool firstFragment = ((bytes[6] & 0x1f) | bytes[7]) == 0;
+  if (bytes[9] != 17 || !firstFragment || size < headerSize + 4) {
+    return CAPTURE_OTHER;
+  }
+  const uint8_t* udp = bytes + headerSize;
+  const uint16_t sourcePort = (udp[0] << 8) | udp[1];
+  const uint16_t destinationPort = (udp[2] << 8) | udp[3];
+  if (sourcePort == RIP_PORT || destinationPort == RIP_PORT || sourcePort == OLSR_PORT || destinationPort == OLSR_PORT) {
+    return CAPTURE_ROUTING;
+  }
+  if (sourcePort == applicationPort || destinationPort == applicationPort) {
+    return CAPTURE_APPLICATION;
+  }
+  return CAPTURE_OTHER;
+}
+
+bool ParseCaptureFilter (const std::string& filter, uint8_t& classes) {
+  classes = 0;
+  std::istringstream names (filter);
+  std::string name;
+  while (std::getline (names, name, ',')) {
+    if (name == "routing") {
+      classes |= CAPTURE_ROUTING;
+    } else if (name == "app") {
+      classes |= CAPTURE_APPLICATION;
+    } else if (name == "other") {
+      classes |= CAPTURE_OTHER;
+    } else if (name == "all") {
+      classes |= CAPTURE_ALL;
+    } else if (name != "none") {
+      return false;
+    }
+  }
+  return true;
+}
+
+PacketCapture::PacketCapture (const std::string& fileName, uint8_t classes, uint32_t snapLen,
+                              uint16_t applicationPort, size_t bufferSize)
+  : m_writer (fileName, bufferSize, true),
+    m_classes (classes),
+    m_snapLen (std::max<uint32_t> (snapLen, 1)),
+    m_applicationPort (applicationPort),
+    m_bytes (std::max (m_snapLen, CLASSIFY_SIZE)),
+    m_captured (0) {
+  // Seção única, sem opções e de tamanho desconhecido
+  m_writer.AppendBinary<uint32_t> (SECTION_HEADER_BLOCK);
+  m_writer.AppendBinary<uint32_t> (28);
+  m_writer.AppendBinary<uint32_t> (0x1a2b3c4d);
+  m_writer.AppendBinary<uint16_t> (1);
+  m_writer.AppendBinary<uint16_t> (0);
+  m_writer.AppendBinary<int64_t> (-1);
+  m_writer.AppendBinary<uint32_t> (28);
+}
+
+void PacketCapture::AppendPadding (uint32_t size) {
+  static const char zeros[4] = {0, 0, 0, 0};
+  m_writer.Append (std::string_view (zeros, (4 - size % 4) % 4));
+}
+
+void PacketCapture::SetNodes (const std::string& names) {
+  std::istringstream list (names);
+  std::string name;
+  while (std::getline (list, name, ',')) {
+    if (!name.empty ()) {
+      m_nodes.insert (name);
+    }
+  }
+}
+
+void PacketCapture::Add (const NetDeviceContainer& devices, uint32_t dataLinkType) {
+  for (uint32_t i = 0; i < devices.GetN (); ++i) {
+    Ptr<NetDevice> device = devices.Get (i);
+    Ptr<Node> node = device->GetNode ();
+    std::string nodeName = Names::FindName (node);
+    if (!m_nodes.empty () && m_nodes.count (nodeName) == 0) {
+      continue;
+    }
+    std::string name = (nodeName.empty () ? std::to_string (node->GetId ()) : nodeName) + "-"
+                       + std::to_string (device->GetIfIndex ());
+
+    // Opções: if_name, if_tsresol (10^-9 s) e fim das opções
+    const uint32_t nameSize = name.size ();
+    const uint32_t blockSize = 20 + 4 + nameSize + (4 - nameSize % 4) % 4 + 8 + 4;
+    m_writer.AppendBinary<uint32_t> (INTERFACE_DESCRIPTION_BLOCK);
+    m_writer.AppendBinary<uint32_t> (blockSize);
+    m_writer.AppendBinary<uint16_t> (dataLinkType);
+    m_writer.AppendBinary<uint16_t> (0);
+    m_writer.AppendBinary<uint32_t> (m_snapLen);
+    m_writer.AppendBinary<uint16_t> (2);
+    m_writer.AppendBinary<uint16_t> (nameSize);
+    m_writer.Append (name);
+    AppendPadding (nameSize);
+    m_writer.AppendBinary<uint16_t> (9);
+    m_writer.AppendBinary<uint16_t> (1);
+    m_writer.AppendBinary<uint32_t> (9);
+    m_writer.AppendBinary<uint32_t> (0);
+    m_writer.AppendBinary<uint32_t> (blockSize);
+
+    uint32_t linkHeaderSize = dataLinkType == PcapHelper::DLT_PPP ? 2 : 14;
+    m_sinks.push_back (std::unique_ptr<Sink> (new Sink {this, static_cast<uint32_t> (m_sinks.size ()), linkHeaderSize}));
+
+    // O Sniffer dos dispositivos ponto a ponto e CSMA é o mesmo usado pelo EnablePcap sem modo promíscuo
+    device->TraceConnectWithoutContext ("Sniffer", MakeBoundCallback (&PacketCapture::Capture, m_sinks.back ().get ()));
+  }
+}
+
+void PacketCapture::Capture (Sink* sink, Ptr<const Packet> packet) {
+  PacketCapture* capture = sink->capture;
+  const uint32_t size = packet->GetSize ();
+  const uint32_t copied = packet->CopyData (capture->m_bytes.data (), capture->m_bytes.size ());
+  if ((capture->Classify (capture->m_bytes.data (), copied, sink->linkHeaderSize) & capture->m_classes) == 0) {
+    return;
+  }
+
+  const uint64_t now = Simulator::Now ().GetNanoSeconds ();
+  const uint32_t included = std::min (copied, capture->m_snapLen);
+  const uint32_t blockSize = 32 + included + (4 - included % 4) % 4;
+  BufferedWriter& writer = capture->m_writer;
+  writer.AppendBinary<uint32_t> (ENHANCED_PACKET_BLOCK);
+  writer.AppendBinary<uint32_t> (blockSize);
+  writer.AppendBinary<uint32_t> (sink->interface);
+  writer.AppendBinary<uint32_t> (now >> 32);
+  writer.AppendBinary<uint32_t> (now & 0xffffffff);
+  writer.AppendBinary<uint32_t> (included);
+  writer.AppendBinary<uint32_t> (size);
+  writer.Append (std::string_view (reinterpret_cast<const char*> (capture->m_bytes.data ()), included));
+  capture->AppendPadding (included);
+  writer.AppendBinary<uint32_t> (blockSize);
+  ++capture->m_captured;
+}
+
+uint8_t PacketCapture::Classify (const uint8_t* bytes, uint32_t size, uint32_t linkHeaderSize) const {
+  // Protocolo IPv4: 0x0021 no PPP, 0x0800 no Ethernet
+  if (size < linkHeaderSize) {
+    return CAPTURE_OTHER;
+  }
+  const uint16_t protocol = (bytes[linkHeaderSize - 2] << 8) | bytes[linkHeaderSize - 1];
+  if (protocol != (linkHeaderSize == 2 ? 0x0021 : 0x0800)) {
+    return CAPTURE_OTHER;
+  }
+  return ClassifyIpv4Packet (bytes + linkHeaderSize, size - linkHeaderSize, m_applicationPort);
+}
+
+} // namespace ns3
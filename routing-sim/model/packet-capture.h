@@ -0,0 +1,118 @@
+#ifndef PACKET_CAPTURE_H
+#define PACKET_CAPTURE_H
+
+#include "buffered-writer.h"
+
+#include "ns3/net-device-container.h"
+#include "ns3/object.h"
+#include "ns3/packet.h"
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * Classes de pacotes capturados, combináveis com |.
+ */
+enum CaptureClass : uint8_t {
+  CAPTURE_ROUTING = 1,     //!< Controle de roteamento: RIP (UDP 520) e OLSR (UDP 698)
+  CAPTURE_APPLICATION = 2, //!< UDP na porta da aplicação
+  CAPTURE_OTHER = 4,       //!< Todos os demais
+  CAPTURE_ALL = 7
+};
+
+/**
+ * Classifica um pacote pelos bytes dos cabeçalhos IPv4 e UDP.
+ *
+ * @param bytes Início do cabeçalho IPv4.
+ * @param size Número de bytes disponíveis.
+ * @param applicationPort Porta UDP da aplicação.
+ * @return Classe do pacote (uma só CaptureClass).
+ */
+uint8_t ClassifyIpv4Packet (const uint8_t* bytes, uint32_t size, uint16_t applicationPort);
+
+/**
+ * Converte uma lista separada por vírgulas de routing, app, other, all ou none.
+ */
+bool ParseCaptureFilter (const std::string& filter, uint8_t& classes);
+
+/**
+ * Captura seletiva em um único arquivo pcapng: só os dispositivos dos nós escolhidos e só os
+ * pacotes das classes escolhidas são gravados, truncados em snapLen bytes, para que a captura
+ * continue barata em topologias grandes.
+ *
+ * Cada dispositivo é uma interface do arquivo (bloco IDB com o nome <nó>-<dispositivo> e timestamps
+ * em nanossegundos), e os pacotes são gravados na ordem dos eventos da simulação, ou seja, já em
+ * ordem de tempo, sem precisar do mergecap. Um único BufferedWriter grava o arquivo em blocos de
+ * bufferSize bytes. A classe do pacote é obtida diretamente dos bytes dos cabeçalhos PPP ou
+ * Ethernet, IPv4 e UDP.
+ */
+class PacketCapture : public Object {
+public:
+  /**
+   * @param fileName Arquivo pcapng.
+   * @param classes Classes capturadas (CaptureClass).
+   * @param snapLen Número máximo de bytes gravados de cada pacote.
+   * @param applicationPort Porta UDP da aplicação.
+   * @param bufferSize Tamanho do buffer do arquivo.
+   */
+  PacketCapture (const std::string& fileName, uint8_t classes, uint32_t snapLen, uint16_t applicationPort,
+                 size_t bufferSize = 1 << 20);
+
+  /**
+   * Restringe a captura aos nós com estes nomes (lista separada por vírgulas); vazio captura todos.
+   * Deve ser chamada antes de Add.
+   */
+  void SetNodes (const std::string& names);
+
+  /**
+   * Captura os dispositivos dos nós escolhidos. Deve ser chamada antes da simulação.
+   *
+   * @param dataLinkType Tipo de enlace do PCAP (PcapHelper::DLT_PPP ou PcapHelper::DLT_EN10MB).
+   */
+  void Add (const NetDeviceContainer& devices, uint32_t dataLinkType);
+
+  /**
+   * Grava o buffer do arquivo.
+   */
+  void Flush () {
+    m_writer.Flush ();
+  }
+
+  /**
+   * @return Número de pacotes gravados.
+   */
+  uint64_t GetCaptured () const {
+    return m_captured;
+  }
+
+private:
+  /**
+   * Interface do arquivo correspondente a um dispositivo.
+   */
+  struct Sink {
+    PacketCapture* capture;
+    uint32_t interface;
+    uint32_t linkHeaderSize;
+  };
+
+  static void Capture (Sink* sink, Ptr<const Packet> packet);
+  uint8_t Classify (const uint8_t* bytes, uint32_t size, uint32_t linkHeaderSize) const;
+  void AppendPadding (uint32_t size);
+
+  BufferedWriter m_writer;
+  uint8_t m_classes;
+  uint32_t m_snapLen;
+  uint16_t m_applicationPort;
+  std::set<std::string> m_nodes;
+  std::vector<std::unique_ptr<Sink>> m_sinks;
+  std::vector<uint8_t> m_bytes; //!< Cópia dos bytes do pacote sendo gravado
+  uint64_t m_captured;
+};
+
+} // namespace ns3
+
+#endif /* PACKET_CAPTURE_H */
@@ -0,0 +1,55 @@
+#include "route-change-log.h"
+
+#include "ns3/simulator.h"
+
+namespace ns3 {
+
+RouteChangeLog::RouteChangeLog (const std::string& fileName, size_t bufferSize)
+  : m_writer(fileName), m_bufferSize(bufferSize) {
+  m_records.reserve (m_bufferSize);
+  m_writer.Append ("time,node,destination,mask,change,old_gateway,old_interface,old_metric,gateway,interface,metric\n");
+}
+
+RouteChangeLog::~RouteChangeLog () {
+  Flush ();
+}
+
+void RouteChangeLog::Record (uint32_t node, RouteChange change, const RouteEntry& before, const RouteEntry& after) {
+  m_records.push_back ({Simulator::Now ().GetNanoSeconds (), node, change, before, after});
+  if (m_records.size () >= m_bufferSize) {
+    Flush ();
+  }
+}
+
+void RouteChangeLog::Flush () {
+  if (m_records.empty ()) {
+    return;
+  }
+  static const char* changeNames[] = {"added", "removed", "metric", "nexthop"};
+  for (const auto& record : m_records) {
+    const RouteEntry& route = record.change == RouteChange::REMOVED ? record.before : record.after;
+    m_writer.AppendFormat ("%.9f,%u,", record.time / 1e9, record.node);
+    m_writer.AppendAddress (route.destination);
+    m_writer.Append (',');
+    m_writer.AppendAddress (route.mask);
+    m_writer.Append (',');
+    m_writer.Append (changeNames[static_cast<uint8_t> (record.change)]);
+    m_writer.Append (',');
+    if (record.change != RouteChange::ADDED) {
+      m_writer.AppendAddress (record.before.gateway);
+      m_writer.AppendFormat (",%u,%u,", record.before.interface, record.before.metric);
+    } else {
+      m_writer.Append (",,,");
+    }
+    if (record.change != RouteChange::REMOVED) {
+      m_writer.AppendAddress (record.after.gateway);
+      m_writer.AppendFormat (",%u,%u\n", record.after.interface, record.after.metric);
+    } else {
+      m_writer.Append (",,\n");
+    }
+  }
+  m_writer.Flush ();
+  m_records.clear ();
+}
+
+} // namespace ns3
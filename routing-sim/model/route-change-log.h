@@ -0,0 +1,59 @@
+#ifndef ROUTE_CHANGE_LOG_H
+#define ROUTE_CHANGE_LOG_H
+
+#include "buffered-writer.h"
+#include "routing-table-snapshot.h"
+
+#include "ns3/object.h"
+
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * Tipo de alteração de uma rota.
+ */
+enum class RouteChange : uint8_t {
+  ADDED,          //!< Rota nova
+  REMOVED,        //!< Rota removida
+  METRIC_CHANGED, //!< Mesmo próximo salto, métrica diferente
+  NEXTHOP_CHANGED //!< Gateway ou interface diferentes
+};
+
+/**
+ * Registro das alterações de rotas de todos os roteadores.
+ *
+ * Os registros são acumulados em memória e gravados em CSV em blocos, por um BufferedWriter, para que o registro
+ * não domine o tempo de execução em simulações longas. Cada linha contém o instante,
+ * o nó, o prefixo, o tipo de alteração e a rota antes e depois da alteração.
+ */
+class RouteChangeLog : public Object {
+public:
+  RouteChangeLog (const std::string& fileName, size_t bufferSize = 4096);
+  ~RouteChangeLog ();
+
+  void Record (uint32_t node, RouteChange change, const RouteEntry& before, const RouteEntry& after);
+
+  /**
+   * Grava os registros acumulados com uma única escrita no arquivo.
+   */
+  void Flush ();
+
+private:
+  struct Entry {
+    int64_t time;
+    uint32_t node;
+    RouteChange change;
+    RouteEntry before;
+    RouteEntry after;
+  };
+
+  BufferedWriter m_writer;
+  size_t m_bufferSize;
+  std::vector<Entry> m_records;
+};
+
+} // namespace ns3
+
+#endif /* ROUTE_CHANGE_LOG_H */
@@ -0,0 +1,66 @@
+#include "routing-table-snapshot.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace ns3 {
+
+namespace {
+const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+const uint64_t FNV_PRIME = 1099511628211ULL;
+} // namespace
+
+bool RouteEntry::operator< (const RouteEntry& other) const {
+  if (destination != other.destination) return destination < other.destination;
+  if (mask != other.mask) return mask < other.mask;
+  if (gateway != other.gateway) return gateway < other.gateway;
+  if (interface != other.interface) return interface < other.interface;
+  return metric < other.metric;
+}
+
+RoutingTableSnapshot::RoutingTableSnapshot () : m_hash(FNV_OFFSET) { }
+
+void RoutingTableSnapshot::Clear () {
+  m_routes.clear ();
+  m_hash = FNV_OFFSET;
+}
+
+void RoutingTableSnapshot::AddOpaque (const char* data, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    m_hash = (m_hash ^ static_cast<uint8_t> (data[i])) * FNV_PRIME;
+  }
+}
+
+void RoutingTableSnapshot::Finalize () {
+  std::sort (m_routes.begin (), m_routes.end ());
+  for (const auto& route : m_routes) {
+    Mix (route.destination);
+    Mix (route.mask);
+    Mix (route.gateway);
+    Mix (route.interface);
+    Mix (route.metric);
+  }
+}
+
+void RoutingTableSnapshot::Swap (RoutingTableSnapshot& other) {
+  m_routes.swap (other.m_routes);
+  std::swap (m_hash, other.m_hash);
+}
+
+void RoutingTableSnapshot::Mix (uint32_t value) {
+  m_hash = (m_hash ^ value) * FNV_PRIME;
+}
+
+ReusableStringBuf::int_type ReusableStringBuf::overflow (int_type ch) {
+  if (!traits_type::eq_int_type (ch, traits_type::eof ())) {
+    m_data.push_back (traits_type::to_char_type (ch));
+  }
+  return traits_type::not_eof (ch);
+}
+
+std::streamsize ReusableStringBuf::xsputn (const char* s, std::streamsize n) {
+  m_data.append (s, n);
+  return n;
+}
+
+} // namespace ns3
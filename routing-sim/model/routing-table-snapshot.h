@@ -0,0 +1,107 @@
+#ifndef ROUTING_TABLE_SNAPSHOT_H
+#define ROUTING_TABLE_SNAPSHOT_H
+
+#include <cstdint>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * Rota extraída de uma tabela de roteamento.
+ */
+struct RouteEntry {
+  uint32_t destination;
+  uint32_t mask;
+  uint32_t gateway;
+  uint32_t interface;
+  uint32_t metric;
+
+  bool operator== (const RouteEntry& other) const {
+    return destination == other.destination && mask == other.mask && gateway == other.gateway
+           && interface == other.interface && metric == other.metric;
+  }
+
+  bool operator!= (const RouteEntry& other) const {
+    return !(*this == other);
+  }
+
+  bool operator< (const RouteEntry& other) const;
+
+  /**
+   * Compara apenas o prefixo (destino e máscara) das rotas.
+   */
+  static bool PrefixLess (const RouteEntry& a, const RouteEntry& b) {
+    return a.destination != b.destination ? a.destination < b.destination : a.mask < b.mask;
+  }
+};
+
+/**
+ * Representação compacta de uma tabela de roteamento: rotas ordenadas e um hash de 64 bits.
+ *
+ * O vetor de rotas é reaproveitado entre leituras, de modo que uma verificação da tabela
+ * não aloca memória depois que a capacidade se estabiliza.
+ */
+class RoutingTableSnapshot {
+public:
+  RoutingTableSnapshot ();
+
+  void Clear ();
+
+  void AddRoute (uint32_t destination, uint32_t mask, uint32_t gateway, uint32_t interface, uint32_t metric) {
+    m_routes.push_back ({destination, mask, gateway, interface, metric});
+  }
+
+  /**
+   * Acrescenta ao hash um conteúdo que não pôde ser interpretado como rotas.
+   */
+  void AddOpaque (const char* data, size_t size);
+
+  /**
+   * Ordena as rotas e calcula o hash. Deve ser chamado após a inserção de todas as rotas.
+   */
+  void Finalize ();
+
+  uint64_t GetHash () const {
+    return m_hash;
+  }
+
+  const std::vector<RouteEntry>& GetRoutes () const {
+    return m_routes;
+  }
+
+  void Swap (RoutingTableSnapshot& other);
+
+private:
+  void Mix (uint32_t value);
+
+  std::vector<RouteEntry> m_routes;
+  uint64_t m_hash;
+};
+
+/**
+ * Buffer de saída que reaproveita a memória entre usos, evitando alocações a cada
+ * impressão da tabela de roteamento.
+ */
+class ReusableStringBuf : public std::streambuf {
+public:
+  void Clear () {
+    m_data.clear ();
+  }
+
+  const std::string& GetData () const {
+    return m_data;
+  }
+
+protected:
+  int_type overflow (int_type ch) override;
+  std::streamsize xsputn (const char* s, std::streamsize n) override;
+
+private:
+  std::string m_data;
+};
+
+} // namespace ns3
+
+#endif /* ROUTING_TABLE_SNAPSHOT_H */
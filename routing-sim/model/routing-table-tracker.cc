@@ -0,0 +1,347 @@
+#include "routing-table-tracker.h"
+
+#include "ns3/ipv4.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/ipv4-list-routing.h"
+#include "ns3/ipv4-static-routing.h"
+#include "ns3/log.h"
+#include "ns3/olsr-routing-protocol.h"
+#include "ns3/rip.h"
+#include "ns3/simulator.h"
+#include "ns3/udp-header.h"
+#include "ns3/udp-l4-protocol.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("RoutingTableTracker");
+
+namespace {
+
+const uint16_t RIP_PORT = 520;
+
+void SkipSpaces (const char*& p, const char* end) {
+  while (p < end && std::isspace (static_cast<unsigned char> (*p))) ++p;
+}
+
+void SkipToken (const char*& p, const char* end) {
+  SkipSpaces (p, end);
+  while (p < end && !std::isspace (static_cast<unsigned char> (*p))) ++p;
+}
+
+uint32_t ParseNumber (const char*& p, const char* end) {
+  SkipSpaces (p, end);
+  uint32_t value = 0;
+  for (; p < end && std::isdigit (static_cast<unsigned char> (*p)); ++p) {
+    value = value * 10 + (*p - '0');
+  }
+  return value;
+}
+
+uint32_t ParseAddress (const char*& p, const char* end) {
+  uint32_t address = 0;
+  for (int i = 0; i < 4; ++i) {
+    address = (address << 8) | (ParseNumber (p, end) & 0xff);
+    if (p < end && *p == '.') ++p;
+  }
+  return address;
+}
+
+} // namespace
+
+bool ParseTrackingMode (const std::string& name, TrackingMode& mode) {
+  if (name == "event") {
+    mode = TrackingMode::EVENT;
+  } else if (name == "adaptive") {
+    mode = TrackingMode::ADAPTIVE;
+  } else if (name == "polling") {
+    mode = TrackingMode::POLLING;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+RoutingTableTracker::RoutingTableTracker (Ptr<Node> node, const TrackingConfig& config, Ptr<RouteChangeLog> log)
+  : m_tracking(false), m_hooks(Hooks::NONE), m_checkPending(false), m_adaptive(false), m_config(config), m_node (node), m_log (log),
+    m_textStream(&m_textBuffer), m_textWrapper(Create<OutputStreamWrapper> (&m_textStream)) { }
+
+void RoutingTableTracker::Start () {
+  m_tracking = true;
+  m_lastChangeTime = Simulator::Now();
+  ReadRoutingTable (m_lastRoutingTable);
+  m_pollEvent.Cancel ();
+  if (m_config.mode == TrackingMode::EVENT && ConnectHooks ()) {
+    // O RIP altera a tabela quando uma rota expira, sem mensagens: polling de segurança
+    if (m_hooks == Hooks::RIP) {
+      m_adaptive = false;
+      m_pollInterval = m_config.pollCeiling;
+      m_pollEvent = Simulator::Schedule (m_pollInterval, &RoutingTableTracker::CheckRoutingTable, this);
+    }
+    return;
+  }
+  m_adaptive = m_config.mode != TrackingMode::POLLING;
+  m_pollInterval = m_adaptive ? m_config.pollFloor : Seconds (.1);
+  m_pollEvent = Simulator::Schedule (m_adaptive ? m_config.pollFloor : Seconds (1.0),
+                                     &RoutingTableTracker::CheckRoutingTable, this);
+  // No polling adaptativo, os ganchos apenas voltam o intervalo ao mínimo
+  if (m_config.mode == TrackingMode::ADAPTIVE) {
+    ConnectHooks ();
+  }
+}
+
+void RoutingTableTracker::Stop () {
+  m_tracking = false;
+  m_pollEvent.Cancel ();
+  DisconnectHooks ();
+}
+
+void RoutingTableTracker::CheckRoutingTable () {
+  if (!m_tracking) {
+    return;
+  }
+  bool changed = UpdateRoutingTable ();
+  if (m_adaptive) {
+    m_pollInterval = changed ? m_config.pollFloor : std::min (m_pollInterval + m_pollInterval, m_config.pollCeiling);
+  }
+  m_pollEvent = Simulator::Schedule (m_pollInterval, &RoutingTableTracker::CheckRoutingTable, this);
+}
+
+void RoutingTableTracker::NotifyLinkEvent () {
+  if (!m_tracking) {
+    return;
+  }
+  if (m_pollEvent.IsRunning ()) {
+    if (m_adaptive) {
+      m_pollInterval = m_config.pollFloor;
+    }
+    m_pollEvent.Cancel ();
+    m_pollEvent = Simulator::ScheduleNow (&RoutingTableTracker::CheckRoutingTable, this);
+  } else {
+    ScheduleCheck ();
+  }
+}
+
+bool RoutingTableTracker::ConnectHooks () {
+  if (m_hooks != Hooks::NONE) {
+    return true;
+  }
+  auto routing = m_node->GetObject<Ipv4> ()->GetRoutingProtocol ();
+  if (routing->TraceConnectWithoutContext ("RoutingTableChanged",
+                                           MakeCallback (&RoutingTableTracker::RoutingTableChanged, this))) {
+    m_hooks = Hooks::OLSR;
+  } else if (DynamicCast<Rip> (routing) != nullptr) {
+    auto ipv4 = m_node->GetObject<Ipv4L3Protocol> ();
+    if (ipv4->TraceConnectWithoutContext ("LocalDeliver", MakeCallback (&RoutingTableTracker::RipPacket, this))) {
+      m_hooks = Hooks::RIP;
+      if (!ipv4->TraceConnectWithoutContext ("SendOutgoing", MakeCallback (&RoutingTableTracker::RipPacket, this))) {
+        DisconnectHooks ();
+      }
+    }
+  }
+  if (m_hooks == Hooks::NONE) {
+    if (m_config.mode == TrackingMode::EVENT) {
+      NS_LOG_WARN ("Nó " << m_node->GetId () << ": protocolo sem ganchos de alteração, usando polling adaptativo.");
+    }
+    return false;
+  }
+  return true;
+}
+
+void RoutingTableTracker::DisconnectHooks () {
+  if (m_hooks == Hooks::OLSR) {
+    m_node->GetObject<Ipv4> ()->GetRoutingProtocol ()->TraceDisconnectWithoutContext (
+        "RoutingTableChanged", MakeCallback (&RoutingTableTracker::RoutingTableChanged, this));
+  } else if (m_hooks == Hooks::RIP) {
+    auto ipv4 = m_node->GetObject<Ipv4L3Protocol> ();
+    ipv4->TraceDisconnectWithoutContext ("LocalDeliver", MakeCallback (&RoutingTableTracker::RipPacket, this));
+    ipv4->TraceDisconnectWithoutContext ("SendOutgoing", MakeCallback (&RoutingTableTracker::RipPacket, this));
+  }
+  m_hooks = Hooks::NONE;
+}
+
+void RoutingTableTracker::ScheduleCheck () {
+  if (!m_tracking || m_checkPending) {
+    return;
+  }
+  m_checkPending = true;
+  Simulator::ScheduleNow (&RoutingTableTracker::CheckPending, this);
+}
+
+void RoutingTableTracker::ControlActivity () {
+  if (!m_adaptive) {
+    ScheduleCheck ();
+  } else if (m_tracking) {
+    m_pollInterval = m_config.pollFloor;
+    if (m_pollEvent.IsRunning () && Simulator::GetDelayLeft (m_pollEvent) > m_pollInterval) {
+      m_pollEvent.Cancel ();
+      m_pollEvent = Simulator::Schedule (m_pollInterval, &RoutingTableTracker::CheckRoutingTable, this);
+    }
+  }
+}
+
+void RoutingTableTracker::RoutingTableChanged (uint32_t size) {
+  ControlActivity ();
+}
+
+void RoutingTableTracker::RipPacket (const Ipv4Header& header, Ptr<const Packet> packet, uint32_t interface) {
+  if (!m_tracking || m_checkPending || header.GetProtocol () != UdpL4Protocol::PROT_NUMBER) {
+    return;
+  }
+  UdpHeader udpHeader;
+  packet->PeekHeader (udpHeader);
+  if (udpHeader.GetDestinationPort () == RIP_PORT) {
+    ControlActivity ();
+  }
+}
+
+void RoutingTableTracker::CheckPending () {
+  m_checkPending = false;
+  if (m_tracking) {
+    UpdateRoutingTable ();
+  }
+}
+
+bool RoutingTableTracker::UpdateRoutingTable () {
+  ReadRoutingTable (m_currentRoutingTable);
+  if (m_currentRoutingTable.GetHash () != m_lastRoutingTable.GetHash ()) {
+    if (m_log != nullptr) {
+      LogChanges (m_lastRoutingTable.GetRoutes (), m_currentRoutingTable.GetRoutes ());
+    }
+    m_lastRoutingTable.Swap (m_currentRoutingTable);
+    m_lastChangeTime = Simulator::Now ();
+    return true;
+  }
+  return false;
+}
+
+void RoutingTableTracker::LogChanges (const std::vector<RouteEntry>& before, const std::vector<RouteEntry>& after) {
+  uint32_t nodeId = m_node->GetId ();
+  auto i = before.begin ();
+  auto j = after.begin ();
+  while (i != before.end () || j != after.end ()) {
+    if (j == after.end () || (i != before.end () && RouteEntry::PrefixLess (*i, *j))) {
+      m_log->Record (nodeId, RouteChange::REMOVED, *i, *i);
+      ++i;
+    } else if (i == before.end () || RouteEntry::PrefixLess (*j, *i)) {
+      m_log->Record (nodeId, RouteChange::ADDED, *j, *j);
+      ++j;
+    } else {
+      if (i->gateway != j->gateway || i->interface != j->interface) {
+        m_log->Record (nodeId, RouteChange::NEXTHOP_CHANGED, *i, *j);
+      } else if (i->metric != j->metric) {
+        m_log->Record (nodeId, RouteChange::METRIC_CHANGED, *i, *j);
+      }
+      ++i;
+      ++j;
+    }
+  }
+}
+
+void RoutingTableTracker::ReadRoutingTable (RoutingTableSnapshot& snapshot) {
+  snapshot.Clear ();
+  ReadRoutes (m_node->GetObject<Ipv4> ()->GetRoutingProtocol (), snapshot);
+  snapshot.Finalize ();
+}
+
+void RoutingTableTracker::ReadRoutes (Ptr<Ipv4RoutingProtocol> routing, RoutingTableSnapshot& snapshot) {
+  if (auto list = DynamicCast<Ipv4ListRouting> (routing)) {
+    int16_t priority;
+    for (uint32_t i = 0; i < list->GetNRoutingProtocols (); ++i) {
+      ReadRoutes (list->GetRoutingProtocol (i, priority), snapshot);
+    }
+  } else if (auto olsr = DynamicCast<olsr::RoutingProtocol> (routing)) {
+    for (const auto& entry : olsr->GetRoutingTableEntries ()) {
+      snapshot.AddRoute (entry.destAddr.Get (), 0xffffffff, entry.nextAddr.Get (), entry.interface, entry.distance);
+    }
+  } else if (auto staticRouting = DynamicCast<Ipv4StaticRouting> (routing)) {
+    for (uint32_t i = 0; i < staticRouting->GetNRoutes (); ++i) {
+      Ipv4RoutingTableEntry entry = staticRouting->GetRoute (i);
+      snapshot.AddRoute (entry.GetDest ().Get (), entry.GetDestNetworkMask ().Get (), entry.GetGateway ().Get (),
+                         entry.GetInterface (), staticRouting->GetMetric (i));
+    }
+  } else {
+    m_textBuffer.Clear ();
+    routing->PrintRoutingTable (m_textWrapper);
+    const std::string& text = m_textBuffer.GetData ();
+    // Ignora a primeira linha (que contém o tempo atual)
+    auto pos = text.find ('\n');
+    pos = (pos == std::string::npos) ? text.size () : pos + 1;
+    if (DynamicCast<Rip> (routing) != nullptr) {
+      ParseRipRoutes (text.data () + pos, text.data () + text.size (), snapshot);
+    } else {
+      snapshot.AddOpaque (text.data () + pos, text.size () - pos);
+    }
+  }
+}
+
+void RoutingTableTracker::ParseRipRoutes (const char* p, const char* end, RoutingTableSnapshot& snapshot) {
+  while (p < end) {
+    const char* eol = std::find (p, end, '\n');
+    if (std::isdigit (static_cast<unsigned char> (*p))) {
+      uint32_t destination = ParseAddress (p, eol);
+      uint32_t gateway = ParseAddress (p, eol);
+      uint32_t mask = ParseAddress (p, eol);
+      SkipToken (p, eol); // Flags
+      uint32_t metric = ParseNumber (p, eol);
+      SkipToken (p, eol); // Ref
+      SkipToken (p, eol); // Use
+      // A interface é impressa pelo índice ou pelo nome do dispositivo, se houver um
+      SkipSpaces (p, eol);
+      uint32_t interface = 0;
+      if (p < eol && std::isdigit (static_cast<unsigned char> (*p))) {
+        interface = ParseNumber (p, eol);
+      } else {
+        interface = 2166136261u;
+        for (; p < eol && !std::isspace (static_cast<unsigned char> (*p)); ++p) {
+          interface = (interface ^ static_cast<uint8_t> (*p)) * 16777619u;
+        }
+      }
+      snapshot.AddRoute (destination, mask, gateway, interface, metric);
+    }
+    p = (eol == end) ? end : eol + 1;
+  }
+}
+
+NetworkConvergenceTracker::NetworkConvergenceTracker (NodeContainer routers, const TrackingConfig& config,
+                                                      Ptr<RouteChangeLog> log) {
+  m_trackers.reserve (routers.GetN ());
+  for (auto i = routers.Begin (); i != routers.End (); ++i) {
+    auto tracker = Create<RoutingTableTracker> (*i, config, log);
+    m_trackers.push_back (tracker);
+  }
+}
+
+void NetworkConvergenceTracker::Start () {
+  m_startTime = Simulator::Now();
+  for (const auto& tracker : m_trackers) {
+    tracker->Start();
+  }
+}
+
+void NetworkConvergenceTracker::Stop () {
+  for (const auto& tracker : m_trackers) {
+    tracker->Stop();
+  }
+}
+
+void NetworkConvergenceTracker::NotifyLinkEvent () {
+  for (const auto& tracker : m_trackers) {
+    tracker->NotifyLinkEvent();
+  }
+}
+
+Time NetworkConvergenceTracker::GetNetworkConvergenceTime () const {
+  Time maxTime = Seconds (0);
+  for (const auto& tracker : m_trackers) {
+    auto convergenceTime = tracker->GetLastChangeTime ();
+    if (convergenceTime > maxTime) {
+      maxTime = convergenceTime;
+    }
+  }
+  return maxTime - m_startTime;
+}
+
+} // namespace ns3
@@ -0,0 +1,194 @@
+#ifndef ROUTING_TABLE_TRACKER_H
+#define ROUTING_TABLE_TRACKER_H
+
+#include "route-change-log.h"
+#include "routing-table-snapshot.h"
+
+#include "ns3/event-id.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/ipv4-routing-protocol.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/output-stream-wrapper.h"
+#include "ns3/packet.h"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * Modo de monitoramento da tabela de roteamento.
+ */
+enum class TrackingMode {
+  POLLING,  //!< Verifica a tabela a cada 100 ms
+  ADAPTIVE, //!< Polling com intervalo crescente enquanto a tabela está estável
+  EVENT     //!< Verifica a tabela apenas quando o protocolo sinaliza uma possível alteração
+};
+
+/**
+ * Configuração do monitoramento das tabelas de roteamento.
+ */
+struct TrackingConfig {
+  TrackingMode mode = TrackingMode::EVENT;
+  Time pollFloor = Seconds (0.1);   //!< Menor intervalo (resolução) do polling adaptativo
+  Time pollCeiling = Seconds (5.0); //!< Maior intervalo do polling adaptativo
+};
+
+/**
+ * Converte o nome do modo de monitoramento (event, adaptive ou polling).
+ */
+bool ParseTrackingMode (const std::string& name, TrackingMode& mode);
+
+/**
+ * Classe para monitorar a tabela de roteamento de um nó.
+ *
+ * No modo EVENT a tabela só é comparada quando o protocolo de roteamento indica uma
+ * possível alteração, registrando o instante exato da mudança:
+ * - OLSR: fonte de rastreamento "RoutingTableChanged", disparada a cada recálculo da tabela;
+ * - RIP: mensagens RIP entregues ao nó ou enviadas por ele. O RIP não possui fontes de
+ *   rastreamento e também altera a tabela sem mensagens: ao desabilitar ou habilitar uma
+ *   interface e quando uma rota expira. As alterações de interface são capturadas por
+ *   NotifyLinkEvent, que deve ser chamado no instante de cada mudança de enlace; as expirações,
+ *   por um polling de segurança com o intervalo máximo, que limita o erro delas a pollCeiling.
+ * Se nenhum dos ganchos puder ser conectado, o monitor usa o polling adaptativo. Os ganchos
+ * são desconectados em Stop.
+ *
+ * No modo ADAPTIVE a tabela é verificada com o intervalo mínimo logo após o início, após uma
+ * alteração detectada, após um evento de enlace (NotifyLinkEvent) ou após atividade de controle
+ * do protocolo (os mesmos ganchos do modo EVENT), e o intervalo dobra a cada verificação sem
+ * alteração até o limite máximo. O instante registrado de uma alteração tem erro de no máximo
+ * pollFloor quando ela decorre de uma mensagem de controle ou de NotifyLinkEvent. As demais
+ * alterações (ex.: expiração de rotas do RIP) e as de protocolos sem ganchos podem ser
+ * registradas até pollCeiling depois, mesmo durante a convergência: as atualizações disparadas
+ * do RIP têm intervalos de 1 a 5 s, durante os quais o intervalo volta a crescer.
+ */
+class RoutingTableTracker : public Object {
+public:
+  RoutingTableTracker (Ptr<Node> node, const TrackingConfig& config = TrackingConfig (), Ptr<RouteChangeLog> log = nullptr);
+
+  void Start ();
+
+  void Stop ();
+
+  void CheckRoutingTable ();
+
+  Time GetLastChangeTime () const {
+    return m_lastChangeTime;
+  }
+
+  /**
+   * Verifica a tabela imediatamente após uma mudança de estado de enlace. No polling
+   * adaptativo, também volta ao intervalo mínimo.
+   */
+  void NotifyLinkEvent ();
+
+private:
+  /**
+   * Ganchos conectados ao nó.
+   */
+  enum class Hooks {
+    NONE,
+    OLSR, //!< Fonte "RoutingTableChanged" do protocolo de roteamento
+    RIP   //!< Fontes "LocalDeliver" e "SendOutgoing" do Ipv4L3Protocol
+  };
+
+  /**
+   * Conecta os ganchos de alteração do protocolo de roteamento do nó.
+   * @return false se o protocolo não oferece nenhum gancho conhecido.
+   */
+  bool ConnectHooks ();
+
+  void DisconnectHooks ();
+
+  /**
+   * Agenda uma verificação para o instante atual, após o protocolo processar o evento.
+   * Várias notificações no mesmo instante resultam em uma única verificação.
+   */
+  void ScheduleCheck ();
+
+  /**
+   * Atividade de controle do protocolo: agenda uma verificação no modo EVENT ou volta o
+   * intervalo do polling adaptativo ao mínimo.
+   */
+  void ControlActivity ();
+
+  void RoutingTableChanged (uint32_t size);
+  void RipPacket (const Ipv4Header& header, Ptr<const Packet> packet, uint32_t interface);
+  void CheckPending ();
+
+  /**
+   * Lê a tabela atual e a compara com a anterior apenas pelo hash de 64 bits, então a verificação
+   * de uma tabela inalterada não percorre as rotas; uma colisão (probabilidade da ordem de 2^-64
+   * por verificação) faria uma alteração passar despercebida. Só quando os hashes diferem as rotas
+   * são comparadas uma a uma, para registrar as alterações.
+   * @return true se a tabela mudou.
+   */
+  bool UpdateRoutingTable ();
+
+  /**
+   * Registra as diferenças entre duas tabelas ordenadas, casando as rotas pelo prefixo.
+   */
+  void LogChanges (const std::vector<RouteEntry>& before, const std::vector<RouteEntry>& after);
+
+  void ReadRoutingTable (RoutingTableSnapshot& snapshot);
+
+  /**
+   * Extrai as rotas de um protocolo de roteamento. OLSR e roteamento estático expõem suas
+   * tabelas diretamente; o RIP só as expõe através de PrintRoutingTable, cuja saída é
+   * interpretada sem cópias intermediárias.
+   */
+  void ReadRoutes (Ptr<Ipv4RoutingProtocol> routing, RoutingTableSnapshot& snapshot);
+
+  /**
+   * Interpreta as linhas "Destination Gateway Genmask Flags Metric Ref Use Iface" de
+   * Rip::PrintRoutingTable. Linhas que não começam com um endereço são ignoradas.
+   */
+  static void ParseRipRoutes (const char* p, const char* end, RoutingTableSnapshot& snapshot);
+
+  bool m_tracking;
+  Hooks m_hooks;
+  bool m_checkPending;
+  bool m_adaptive;
+  TrackingConfig m_config;
+  Time m_pollInterval;
+  EventId m_pollEvent;
+  Ptr<Node> m_node;
+  Ptr<RouteChangeLog> m_log;
+  ReusableStringBuf m_textBuffer;
+  std::ostream m_textStream;
+  Ptr<OutputStreamWrapper> m_textWrapper;
+  RoutingTableSnapshot m_lastRoutingTable;
+  RoutingTableSnapshot m_currentRoutingTable;
+  Time m_lastChangeTime;
+};
+
+/**
+ * Classe para monitorar a convergência da rede.
+ */
+class NetworkConvergenceTracker : public Object {
+public:
+  NetworkConvergenceTracker (NodeContainer routers, const TrackingConfig& config = TrackingConfig (),
+                             Ptr<RouteChangeLog> log = nullptr);
+
+  void Start ();
+  void Stop ();
+
+  /**
+   * Verifica as tabelas imediatamente, capturando as alterações causadas diretamente
+   * por uma mudança de estado de enlace.
+   */
+  void NotifyLinkEvent ();
+
+  Time GetNetworkConvergenceTime () const;
+
+private:
+  std::vector<Ptr<RoutingTableTracker>> m_trackers;
+  Time m_startTime;
+};
+
+} // namespace ns3
+
+#endif /* ROUTING_TABLE_TRACKER_H */
@@ -0,0 +1,66 @@
+#include "run-summary.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace ns3 {
+
+void RunSummary::Add (const std::string& key, double value) {
+  m_values.emplace_back (key, value);
+}
+
+double RunSummary::Get (const std::string& key, double value) const {
+  for (const auto& entry : m_values) {
+    if (entry.first == key) {
+      return entry.second;
+    }
+  }
+  return value;
+}
+
+bool RunSummary::Write (const std::string& fileName) const {
+  std::string line;
+  char number[32];
+  for (const auto& entry : m_values) {
+    if (!line.empty ()) {
+      line += ',';
+    }
+    std::snprintf (number, sizeof (number), "%.17g", entry.second);
+    line += entry.first;
+    line += '=';
+    line += number;
+  }
+  line += '\n';
+
+  std::ofstream file (fileName);
+  file.write (line.data (), line.size ());
+  return static_cast<bool> (file);
+}
+
+bool RunSummary::Read (const std::string& fileName) {
+  std::ifstream file (fileName);
+  std::string line;
+  if (!std::getline (file, line)) {
+    return false;
+  }
+  m_values.clear ();
+  std::istringstream fields (line);
+  std::string field;
+  while (std::getline (fields, field, ',')) {
+    size_t equals = field.find ('=');
+    if (equals == std::string::npos) {
+      return false;
+    }
+    char* end;
+    double value = std::strtod (field.c_str () + equals + 1, &end);
+    if (*end != '\0') {
+      return false;
+    }
+    m_values.emplace_back (field.substr (0, equals), value);
+  }
+  return true;
+}
+
+} // namespace ns3
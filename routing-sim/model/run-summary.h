@@ -0,0 +1,40 @@
+#ifndef RUN_SUMMARY_H
+#define RUN_SUMMARY_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * Resultado numérico de uma execução, gravado em uma única linha "chave=valor,chave=valor,..."
+ * para ser lido pelo sweep sem depender do texto impresso na saída padrão.
+ */
+class RunSummary {
+public:
+  void Add (const std::string& key, double value);
+
+  /**
+   * @return Valor da chave, ou value se a chave não existe.
+   */
+  double Get (const std::string& key, double value = 0) const;
+
+  const std::vector<std::pair<std::string, double>>& GetValues () const {
+    return m_values;
+  }
+
+  bool Write (const std::string& fileName) const;
+
+  /**
+   * @return false se o arquivo não existe ou está mal formado.
+   */
+  bool Read (const std::string& fileName);
+
+private:
+  std::vector<std::pair<std::string, double>> m_values;
+};
+
+} // namespace ns3
+
+#endif /* RUN_SUMMARY_H */
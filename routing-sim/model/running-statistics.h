@@ -0,0 +1,59 @@
+#ifndef RUNNING_STATISTICS_H
+#define RUNNING_STATISTICS_H
+
+#include <cstdint>
+
+namespace ns3 {
+
+/**
+ * Média e variância de uma amostra calculadas incrementalmente (algoritmo de Welford),
+ * sem guardar os valores: cada valor é acumulado em tempo constante e sem perda de precisão
+ * quando a variância é pequena em relação à média.
+ */
+class RunningStatistics {
+public:
+  void Add (double value);
+
+  uint64_t GetCount () const {
+    return m_count;
+  }
+
+  double GetMean () const {
+    return m_mean;
+  }
+
+  /**
+   * @return Variância amostral (divisor n - 1), ou 0 com menos de dois valores.
+   */
+  double GetVariance () const;
+
+  double GetStandardDeviation () const;
+
+  /**
+   * Meia-largura do intervalo de confiança da média, com o quantil da distribuição t de Student.
+   *
+   * @param confidence Nível de confiança, entre 0 e 1.
+   * @return Meia-largura do intervalo, ou infinito com menos de dois valores.
+   */
+  double GetConfidenceHalfWidth (double confidence = 0.95) const;
+
+private:
+  uint64_t m_count = 0;
+  double m_mean = 0;
+  double m_m2 = 0; //!< Soma dos quadrados dos desvios em relação à média
+};
+
+/**
+ * Quantil da distribuição t de Student. Até 30 graus de liberdade, a expansão de Cornish-Fisher a
+ * partir do quantil normal, que subestima as caudas com poucos graus, é refinada pelo método de
+ * Newton sobre a distribuição exata (função beta incompleta), com erro relativo abaixo de 1e-9;
+ * acima disso, a expansão já tem erro relativo abaixo de 1e-5 e é usada diretamente.
+ *
+ * @param probability Probabilidade acumulada, entre 0 e 1.
+ * @param degreesOfFreedom Graus de liberdade.
+ */
+double StudentTQuantile (double probability, double degreesOfFreedom);
+
+} // namespace ns3
+
+#endif /* RUNNING_STATISTICS_H */
@@ -0,0 +1,120 @@
+#include "sequence-gap-detector.h"
+
+#include "ns3/seq-ts-header.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace ns3 {
+
+SequenceGapDetector::SequenceGapDetector ()
+  : m_nextSeq (0),
+    m_interval (Time (0)),
+    m_receiving (false) {
+}
+
+void SequenceGapDetector::Install (ApplicationContainer servers) {
+  for (uint32_t i = 0; i < servers.GetN (); ++i) {
+    servers.Get (i)->TraceConnectWithoutContext ("RxWithAddresses",
+                                                 MakeCallback (&SequenceGapDetector::Received, this));
+  }
+}
+
+void SequenceGapDetector::AddEvent (Time event) {
+  Outage outage = {event, event, event, 0, 0, 0, 0, true};
+  m_outages.insert (std::upper_bound (m_outages.begin (), m_outages.end (), outage,
+                                      [] (const Outage& a, const Outage& b) { return a.event < b.event; }),
+                    outage);
+}
+
+void SequenceGapDetector::Received (Ptr<const Packet> packet, const Address& from, const Address& local) {
+  SeqTsHeader header;
+  packet->PeekHeader (header);
+  const uint32_t seq = header.GetSeq ();
+  const Time sent = header.GetTs ();
+  const Time now = Simulator::Now ();
+
+  if (seq < m_nextSeq) {
+    // Pacote atrasado: deixa de contar como perdido no salto que o incluiu
+    for (auto& outage : m_outages) {
+      if (outage.gaps > 0 && outage.lostPackets > 0 && seq >= outage.firstLost && seq <= outage.lastLost) {
+        --outage.lostPackets;
+        break;
+      }
+    }
+    return;
+  }
+  if (m_receiving) {
+    // Com taxa constante, o intervalo é a diferença entre os envios dividida pelos números de sequência
+    m_interval = TimeStep ((sent - m_lastSent).GetTimeStep () / static_cast<int64_t> (seq - m_nextSeq + 1));
+    if (seq > m_nextSeq) {
+      AddGap (m_nextSeq, seq - 1, m_lastSent + m_interval, m_lastReceived, now, true);
+    }
+  }
+  m_nextSeq = seq + 1;
+  m_lastReceived = now;
+  m_lastSent = sent;
+  m_receiving = true;
+}
+
+void SequenceGapDetector::AddGap (uint32_t firstLost, uint32_t lastLost, Time lostSent, Time start, Time end,
+                                  bool recovered) {
+  // Último evento até o envio do primeiro pacote perdido; os saltos antes do primeiro evento não são atribuídos
+  auto outage = std::upper_bound (m_outages.begin (), m_outages.end (), lostSent,
+                                  [] (const Time& t, const Outage& o) { return t < o.event; });
+  if (outage == m_outages.begin ()) {
+    return;
+  }
+  --outage;
+  if (outage->gaps == 0) {
+    outage->start = start;
+    outage->firstLost = firstLost;
+  }
+  outage->end = end;
+  outage->lastLost = lastLost;
+  outage->lostPackets += lastLost - firstLost + 1;
+  outage->recovered = recovered;
+  ++outage->gaps;
+}
+
+void SequenceGapDetector::Finish () {
+  if (!m_receiving || m_interval <= Time (0)) {
+    return;
+  }
+  // Há um salto final se o pacote seguinte ao último recebido, com o mesmo atraso, já deveria ter
+  // chegado com folga de um intervalo; os pacotes ainda em trânsito no fim não são contados
+  const Time now = Simulator::Now ();
+  const Time lostSent = m_lastSent + m_interval;
+  const Time delay = m_lastReceived - m_lastSent;
+  if (lostSent + delay + m_interval >= now) {
+    return;
+  }
+  const uint32_t lost = (now - delay - lostSent).GetTimeStep () / m_interval.GetTimeStep () + 1;
+  AddGap (m_nextSeq, m_nextSeq + lost - 1, lostSent, m_lastReceived, now, false);
+
+  // Os eventos durante o salto final também não tiveram o tráfego restabelecido
+  for (auto& outage : m_outages) {
+    if (outage.event > lostSent && outage.gaps == 0) {
+      outage.start = m_lastReceived;
+      outage.end = now;
+      outage.gaps = 1;
+      outage.recovered = false;
+    }
+  }
+}
+
+void PrintDataPlaneOutage (const std::string& label, const SequenceGapDetector::Outage& outage, Time convergence) {
+  std::cout << label << ": convergência das rotas em " << convergence.GetSeconds () << " s, ";
+  if (outage.gaps == 0) {
+    std::cout << "tráfego sem interrupção\n";
+  } else if (!outage.recovered) {
+    std::cout << "tráfego interrompido desde " << outage.start.GetSeconds () << " s e não restabelecido\n";
+  } else {
+    std::cout << "tráfego restabelecido em " << outage.GetRecoveryTime ().GetSeconds () << " s (sem pacotes de "
+              << outage.start.GetSeconds () << " s a " << outage.end.GetSeconds () << " s, "
+              << outage.lostPackets << " pacotes perdidos)\n";
+  }
+}
+
+} // namespace ns3
@@ -0,0 +1,108 @@
+#ifndef SEQUENCE_GAP_DETECTOR_H
+#define SEQUENCE_GAP_DETECTOR_H
+
+#include "ns3/address.h"
+#include "ns3/application-container.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/packet.h"
+
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * Mede a interrupção do tráfego (plano de dados) após cada queda ou retorno de enlace pelos saltos
+ * nos números de sequência do SeqTsHeader recebidos por um UdpServer, para comparar com o tempo
+ * de convergência das tabelas de roteamento (plano de controle).
+ *
+ * Um salto é delimitado pelo último pacote recebido antes dele e pelo primeiro recebido depois.
+ * Cada salto é atribuído ao último evento (ver AddEvent) até o envio do primeiro pacote perdido,
+ * estimado pelo instante de envio (SeqTsHeader) do último pacote recebido mais o intervalo entre
+ * os envios do transmissor, que deve ter taxa constante. Assim, uma interrupção que atravessa
+ * outros eventos fica com o evento que a causou. Se houver mais de um salto no mesmo evento, a
+ * interrupção vai do início do primeiro ao fim do último. Pacotes atrasados que preenchem um
+ * salto já registrado são descontados das perdas.
+ */
+class SequenceGapDetector : public Object {
+public:
+  /**
+   * Interrupção do tráfego atribuída a um evento.
+   */
+  struct Outage {
+    Time event;
+    Time start;           //!< Recepção do último pacote antes do primeiro salto
+    Time end;             //!< Recepção do primeiro pacote depois do último salto
+    uint32_t gaps;        //!< Saltos atribuídos ao evento, incluindo o que não terminou
+    uint64_t lostPackets;
+    uint32_t firstLost;   //!< Primeiro número de sequência perdido
+    uint32_t lastLost;    //!< Último número de sequência perdido
+    bool recovered;       //!< false se nenhum pacote foi recebido depois do salto
+
+    /**
+     * @return Tempo sem receber pacotes (zero sem saltos).
+     */
+    Time GetDuration () const {
+      return gaps > 0 ? end - start : Time (0);
+    }
+
+    /**
+     * @return Tempo entre o evento e o primeiro pacote recebido depois da interrupção (zero sem saltos).
+     */
+    Time GetRecoveryTime () const {
+      return gaps > 0 ? end - event : Time (0);
+    }
+  };
+
+  SequenceGapDetector ();
+
+  /**
+   * Passa a acompanhar os pacotes recebidos pelos UdpServer do contêiner, que devem receber um
+   * único fluxo (os números de sequência de fluxos diferentes não são separados).
+   */
+  void Install (ApplicationContainer servers);
+
+  /**
+   * Registra o instante de uma queda ou retorno de enlace. Os eventos devem ser registrados antes da simulação.
+   */
+  void AddEvent (Time event);
+
+  /**
+   * Encerra a interrupção em andamento, se o tráfego não voltou até o fim da simulação (o transmissor
+   * deve enviar até o fim): o salto final é atribuído ao evento que o iniciou, e os eventos
+   * posteriores também ficam sem o tráfego restabelecido. Deve ser chamada depois da simulação.
+   */
+  void Finish ();
+
+  /**
+   * @return Interrupção de cada evento, na ordem dos instantes.
+   */
+  const std::vector<Outage>& GetOutages () const {
+    return m_outages;
+  }
+
+private:
+  void Received (Ptr<const Packet> packet, const Address& from, const Address& local);
+  /**
+   * @param lostSent Instante de envio do primeiro pacote perdido, que define o evento do salto.
+   */
+  void AddGap (uint32_t firstLost, uint32_t lastLost, Time lostSent, Time start, Time end, bool recovered);
+
+  uint32_t m_nextSeq;
+  Time m_lastReceived;
+  Time m_lastSent;  //!< Instante de envio do último pacote recebido em ordem
+  Time m_interval;  //!< Intervalo entre os envios, medido entre pacotes recebidos
+
+  bool m_receiving;
+  std::vector<Outage> m_outages;
+};
+
+/**
+ * Imprime a interrupção do tráfego após um evento e o tempo de convergência das rotas no mesmo evento.
+ */
+void PrintDataPlaneOutage (const std::string& label, const SequenceGapDetector::Outage& outage, Time convergence);
+
+} // namespace ns3
+
+#endif /* SEQUENCE_GAP_DETECTOR_H */
@@ -0,0 +1,52 @@
+#include "subnet-allocator.h"
+
+#include <cstdlib>
+
+namespace ns3 {
+
+SubnetAllocator::SubnetAllocator () {
+  SetPool ("10.0.0.0/8", 30);
+}
+
+bool SubnetAllocator::SetPool (const std::string& pool, uint8_t prefixLength) {
+  size_t slash = pool.find ('/');
+  if (slash == std::string::npos) {
+    return false;
+  }
+  char* end;
+  unsigned long poolPrefix = std::strtoul (pool.c_str () + slash + 1, &end, 10);
+  if (*end != '\0' || end == pool.c_str () + slash + 1 || poolPrefix > prefixLength || prefixLength > 31) {
+    return false;
+  }
+
+  uint32_t poolMask = poolPrefix == 0 ? 0 : UINT32_MAX << (32 - poolPrefix);
+  m_base = Ipv4Address (pool.substr (0, slash).c_str ()).Get () & poolMask;
+  m_mask = prefixLength == 0 ? 0 : UINT32_MAX << (32 - prefixLength);
+  m_prefixLength = prefixLength;
+  m_subnetSize = uint64_t (1) << (32 - prefixLength);
+  m_capacity = uint64_t (1) << (prefixLength - poolPrefix);
+  m_networks.clear ();
+  return true;
+}
+
+void SubnetAllocator::Reserve (size_t subnets) {
+  m_networks.reserve (subnets);
+}
+
+uint32_t SubnetAllocator::Allocate () {
+  if (m_networks.size () >= m_capacity) {
+    return NOT_AVAILABLE;
+  }
+  m_networks.push_back (m_base + static_cast<uint32_t> (m_networks.size () * m_subnetSize));
+  return m_networks.size () - 1;
+}
+
+uint32_t SubnetAllocator::FindSubnet (Ipv4Address address) const {
+  uint64_t offset = static_cast<uint64_t> (address.Get ()) - m_base;
+  if (address.Get () < m_base || offset / m_subnetSize >= m_networks.size ()) {
+    return NOT_AVAILABLE;
+  }
+  return offset / m_subnetSize;
+}
+
+} // namespace ns3
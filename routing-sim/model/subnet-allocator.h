@@ -0,0 +1,90 @@
+#ifndef SUBNET_ALLOCATOR_H
+#define SUBNET_ALLOCATOR_H
+
+#include "ns3/ipv4-address.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * Distribui sub-redes de tamanho fixo de um bloco de endereços, uma por enlace.
+ *
+ * Cada alocação é O(1): a próxima sub-rede é calculada a partir do índice, e o endereço de rede
+ * de cada sub-rede alocada fica em uma tabela contígua, indexada pela ordem de alocação.
+ * Em /31 (RFC 3021) não há endereço de rede nem de broadcast e os dois endereços são usados.
+ */
+class SubnetAllocator {
+public:
+  static const uint32_t NOT_AVAILABLE = UINT32_MAX;
+
+  /**
+   * Sub-redes /30 do bloco 10.0.0.0/8.
+   */
+  SubnetAllocator ();
+
+  /**
+   * Define o bloco e o tamanho das sub-redes e descarta as alocações anteriores.
+   *
+   * @param pool Bloco no formato endereço/prefixo (ex.: "10.0.0.0/8").
+   * @param prefixLength Prefixo das sub-redes alocadas (ex.: 24, 30 ou 31).
+   * @return false se o bloco é inválido ou o prefixo não cabe nele.
+   */
+  bool SetPool (const std::string& pool, uint8_t prefixLength);
+
+  void Reserve (size_t subnets);
+
+  /**
+   * @return Índice da sub-rede alocada, ou NOT_AVAILABLE se o bloco se esgotou.
+   */
+  uint32_t Allocate ();
+
+  /**
+   * @return Índice da sub-rede alocada que contém o endereço, ou NOT_AVAILABLE.
+   */
+  uint32_t FindSubnet (Ipv4Address address) const;
+
+  Ipv4Address GetNetwork (uint32_t subnet) const {
+    return Ipv4Address (m_networks[subnet]);
+  }
+
+  /**
+   * @param host Posição do host na sub-rede, de 0 a GetHostCount () - 1.
+   */
+  Ipv4Address GetHostAddress (uint32_t subnet, uint32_t host) const {
+    return Ipv4Address (m_networks[subnet] + (m_prefixLength == 31 ? 0 : 1) + host);
+  }
+
+  Ipv4Mask GetMask () const {
+    return Ipv4Mask (m_mask);
+  }
+
+  uint32_t GetHostCount () const {
+    return m_prefixLength == 31 ? 2 : m_subnetSize - 2;
+  }
+
+  /**
+   * @return Número de sub-redes ainda disponíveis no bloco.
+   */
+  uint64_t GetAvailable () const {
+    return m_capacity - m_networks.size ();
+  }
+
+  uint32_t GetN () const {
+    return m_networks.size ();
+  }
+
+private:
+  uint32_t m_base;
+  uint32_t m_mask;
+  uint8_t m_prefixLength;
+  uint64_t m_subnetSize;
+  uint64_t m_capacity;
+  std::vector<uint32_t> m_networks;
+};
+
+} // namespace ns3
+
+#endif /* SUBNET_ALLOCATOR_H */
@@ -0,0 +1,201 @@
+#include "sweep-runner.h"
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+
+namespace ns3 {
+
+void AppendField (std::string& text, const std::string& field) {
+  if (field.find_first_of (",\"\r\n") == std::string::npos) {
+    text += field;
+    return;
+  }
+  text += '"';
+  for (char c : field) {
+    if (c == '"') {
+      text += '"';
+    }
+    text += c;
+  }
+  text += '"';
+}
+
+namespace {
+
+void AddKey (std::vector<std::string>& keys, const std::string& key) {
+  if (std::find (keys.begin (), keys.end (), key) == keys.end ()) {
+    keys.push_back (key);
+  }
+}
+
+} // namespace
+
+SweepRunner::SweepRunner (const std::string& program, uint32_t parallelJobs)
+  : m_program (program),
+    m_parallelJobs (parallelJobs > 0 ? parallelJobs : 1) {
+}
+
+uint32_t SweepRunner::AddJob (const SweepJob& job) {
+  m_jobs.push_back (job);
+  m_success.push_back (false);
+  m_summaries.emplace_back ();
+  return m_jobs.size () - 1;
+}
+
+pid_t SweepRunner::Launch (uint32_t job) const {
+  const SweepJob& description = m_jobs[job];
+  // Remove o resumo de um sweep anterior na mesma pasta, que seria lido se a execução não gravar o seu
+  std::error_code error;
+  std::filesystem::create_directories (description.directory, error);
+  std::filesystem::remove (description.directory + "/summary.txt", error);
+
+  // Tudo o que o filho precisa é preparado antes do fork
+  std::string summary = "--summary=" + description.directory + "/summary.txt";
+  std::string log = description.directory + "/run.log";
+  std::vector<char*> argv;
+  argv.reserve (description.arguments.size () + 3);
+  argv.push_back (const_cast<char*> (m_program.c_str ()));
+  for (const auto& argument : description.arguments) {
+    argv.push_back (const_cast<char*> (argument.c_str ()));
+  }
+  argv.push_back (const_cast<char*> (summary.c_str ()));
+  argv.push_back (nullptr);
+
+  pid_t pid = fork ();
+  if (pid == 0) {
+    int fd = open (log.c_str (), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0) {
+      dup2 (fd, STDOUT_FILENO);
+      dup2 (fd, STDERR_FILENO);
+      close (fd);
+    }
+    execv (m_program.c_str (), argv.data ());
+    _exit (127);
+  }
+  return pid;
+}
+
+uint32_t SweepRunner::Run () {
+  std::unordered_map<pid_t, uint32_t> running;
+  uint32_t next = 0;
+  uint32_t finished = 0;
+  uint32_t failures = 0;
+
+  while (next < m_jobs.size () || !running.empty ()) {
+    while (next < m_jobs.size () && running.size () < m_parallelJobs) {
+      pid_t pid = Launch (next);
+      if (pid < 0) {
+        std::cerr << "Falha ao criar o processo da execução " << next << "\n";
+        ++failures;
+        ++finished;
+        if (m_jobFinished) {
+          m_jobFinished (next);
+        }
+      } else {
+        running.emplace (pid, next);
+      }
+      ++next;
+    }
+    if (running.empty ()) {
+      continue;
+    }
+
+    int status;
+    pid_t pid = waitpid (-1, &status, 0);
+    if (pid < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+    auto it = running.find (pid);
+    if (it == running.end ()) {
+      continue;
+    }
+    uint32_t job = it->second;
+    running.erase (it);
+
+    m_success[job] = WIFEXITED (status) && WEXITSTATUS (status) == 0
+                     && m_summaries[job].Read (m_jobs[job].directory + "/summary.txt");
+    failures += m_success[job] ? 0 : 1;
+    ++finished;
+
+    std::cout << "[" << finished << "/" << m_jobs.size () << "]";
+    for (const auto& parameter : m_jobs[job].parameters) {
+      std::cout << " " << parameter.first << "=" << parameter.second;
+    }
+    std::cout << (m_success[job] ? "" : " (falhou, veja " + m_jobs[job].directory + "/run.log)") << std::endl;
+
+    if (m_jobFinished) {
+      m_jobFinished (job);
+    }
+  }
+  return failures;
+}
+
+bool SweepRunner::WriteTable (const std::string& fileName) const {
+  std::vector<std::string> parameters;
+  for (const auto& job : m_jobs) {
+    for (const auto& parameter : job.parameters) {
+      AddKey (parameters, parameter.first);
+    }
+  }
+  std::vector<std::string> keys;
+  for (const auto& summary : m_summaries) {
+    for (const auto& value : summary.GetValues ()) {
+      AddKey (keys, value.first);
+    }
+  }
+
+  std::string text;
+  for (const auto& parameter : parameters) {
+    AppendField (text, parameter);
+    text += ",";
+  }
+  text += "status";
+  for (const auto& key : keys) {
+    text += ",";
+    AppendField (text, key);
+  }
+  text += "\n";
+
+  char number[32];
+  for (uint32_t i = 0; i < m_jobs.size (); ++i) {
+    for (const auto& parameter : parameters) {
+      for (const auto& value : m_jobs[i].parameters) {
+        if (value.first == parameter) {
+          AppendField (text, value.second);
+          break;
+        }
+      }
+      text += ",";
+    }
+    text += m_success[i] ? "ok" : "falhou";
+    for (const auto& key : keys) {
+      text += ",";
+      for (const auto& value : m_summaries[i].GetValues ()) {
+        if (value.first == key) {
+          std::snprintf (number, sizeof (number), "%.9g", value.second);
+          text += number;
+          break;
+        }
+      }
+    }
+    text += "\n";
+  }
+
+  std::ofstream file (fileName);
+  file.write (text.data (), text.size ());
+  return static_cast<bool> (file);
+}
+
+} // namespace ns3
@@ -0,0 +1,98 @@
+#ifndef SWEEP_RUNNER_H
+#define SWEEP_RUNNER_H
+
+#include "run-summary.h"
+
+#include <sys/types.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * Acrescenta um campo CSV, entre aspas (com as aspas duplicadas) se contém vírgula, aspas ou quebra de linha.
+ */
+void AppendField (std::string& text, const std::string& field);
+
+/**
+ * Uma execução do sweep.
+ */
+struct SweepJob {
+  std::vector<std::pair<std::string, std::string>> parameters; //!< Colunas que identificam a execução na tabela
+  std::vector<std::string> arguments;                          //!< Argumentos passados ao programa
+  std::string directory; //!< Pasta da execução, com a saída do programa (run.log) e o resumo (summary.txt)
+};
+
+/**
+ * Executa um programa de simulação várias vezes, em processos independentes, com no máximo
+ * parallelJobs processos simultâneos retirados de uma fila de execuções.
+ *
+ * Cada execução recebe --summary=<pasta>/summary.txt e deve gravar nele um RunSummary; ao final,
+ * os resumos são reunidos em uma tabela CSV com uma linha por execução.
+ */
+class SweepRunner {
+public:
+  /**
+   * @param program Caminho do executável.
+   * @param parallelJobs Número máximo de processos simultâneos.
+   */
+  SweepRunner (const std::string& program, uint32_t parallelJobs);
+
+  /**
+   * @return Índice da execução.
+   */
+  uint32_t AddJob (const SweepJob& job);
+
+  /**
+   * Define a função chamada ao término de cada execução, com o seu índice, antes de iniciar as próximas.
+   * A função pode chamar AddJob para acrescentar execuções à fila, o que permite decidir quantas
+   * execuções fazer a partir dos resultados das anteriores.
+   */
+  void SetJobFinishedCallback (std::function<void (uint32_t)> callback) {
+    m_jobFinished = callback;
+  }
+
+  /**
+   * Executa todas as execuções da fila e aguarda o seu término.
+   *
+   * @return Número de execuções que falharam.
+   */
+  uint32_t Run ();
+
+  bool IsSuccessful (uint32_t job) const {
+    return m_success[job];
+  }
+
+  const RunSummary& GetSummary (uint32_t job) const {
+    return m_summaries[job];
+  }
+
+  uint32_t GetNJobs () const {
+    return m_jobs.size ();
+  }
+
+  /**
+   * Grava a tabela com os parâmetros, o estado e os valores do resumo de cada execução.
+   * As colunas dos parâmetros e dos resumos são a união das chaves, na ordem em que aparecem; o
+   * campo fica vazio se a execução não tem a chave. Campos com vírgulas ou aspas vão entre aspas.
+   */
+  bool WriteTable (const std::string& fileName) const;
+
+private:
+  pid_t Launch (uint32_t job) const;
+
+  std::string m_program;
+  uint32_t m_parallelJobs;
+  std::vector<SweepJob> m_jobs;
+  std::vector<bool> m_success;
+  std::vector<RunSummary> m_summaries;
+  std::function<void (uint32_t)> m_jobFinished;
+};
+
+} // namespace ns3
+
+#endif /* SWEEP_RUNNER_H */
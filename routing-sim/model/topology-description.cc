@@ -0,0 +1,63 @@
+#include "topology-description.h"
+
+namespace ns3 {
+
+void TopologyDescription::Reserve (size_t nodes, size_t links) {
+  m_nodes.reserve (nodes);
+  m_nodeIndex.reserve (nodes);
+  m_links.reserve (links);
+  m_linkIndex.reserve (links);
+}
+
+uint32_t TopologyDescription::AddNode (const std::string& name, bool router, double x, double y) {
+  uint32_t index = m_nodes.size ();
+  if (!m_nodeIndex.emplace (name, index).second) {
+    return NOT_FOUND;
+  }
+  m_nodes.push_back ({name, router, x, y});
+  return index;
+}
+
+uint32_t TopologyDescription::AddLink (uint32_t node1, uint32_t node2, ChannelType type, uint64_t dataRate,
+                                       Time delay, uint8_t cost) {
+  uint32_t index = m_links.size ();
+  m_links.push_back ({node1, node2, type, dataRate, delay, cost});
+  m_linkIndex.emplace (LinkKey (node1, node2), index);
+  return index;
+}
+
+void TopologyDescription::AddFailure (uint32_t link, Time down, Time up) {
+  m_failures.push_back ({FailureTarget::LINK, link, down, up, 1, Time (0)});
+}
+
+void TopologyDescription::AddFailure (const FailureDescription& failure) {
+  m_failures.push_back (failure);
+}
+
+void TopologyDescription::AddRandomFailure (const RandomFailureDescription& failure) {
+  m_randomFailures.push_back (failure);
+}
+
+void TopologyDescription::SetFailureTimes (Time down, Time up) {
+  for (auto& failure : m_failures) {
+    failure.down = down;
+    failure.up = up;
+  }
+}
+
+void TopologyDescription::ClearFailures () {
+  m_failures.clear ();
+  m_randomFailures.clear ();
+}
+
+uint32_t TopologyDescription::FindNode (const std::string& name) const {
+  auto it = m_nodeIndex.find (name);
+  return it == m_nodeIndex.end () ? NOT_FOUND : it->second;
+}
+
+uint32_t TopologyDescription::FindLink (uint32_t node1, uint32_t node2) const {
+  auto it = m_linkIndex.find (LinkKey (node1, node2));
+  return it == m_linkIndex.end () ? NOT_FOUND : it->second;
+}
+
+} // namespace ns3
@@ -0,0 +1,150 @@
+#ifndef TOPOLOGY_DESCRIPTION_H
+#define TOPOLOGY_DESCRIPTION_H
+
+#include "ns3/nstime.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * Tipo de canal de um enlace.
+ */
+enum class ChannelType : uint8_t {
+  POINT_TO_POINT,
+  CSMA
+};
+
+/**
+ * Nó da topologia. Hosts (origem e destino do tráfego) não têm a convergência monitorada.
+ */
+struct NodeDescription {
+  std::string name;
+  bool router;
+  double x; //!< Posição para o NetAnim
+  double y;
+};
+
+/**
+ * Enlace entre dois nós, identificados pelos seus índices na topologia.
+ */
+struct LinkDescription {
+  uint32_t node1;
+  uint32_t node2;
+  ChannelType type;
+  uint64_t dataRate; //!< bps
+  Time delay;
+  uint8_t cost;      //!< Métrica RIP das duas interfaces do enlace (1 a 15)
+};
+
+/**
+ * Elemento afetado por uma falha.
+ */
+enum class FailureTarget : uint8_t {
+  LINK,     //!< Um enlace
+  NODE,     //!< Todos os enlaces de um nó, ao mesmo tempo
+  ALL_LINKS //!< Cada enlace da topologia, de forma independente (só em falhas aleatórias)
+};
+
+/**
+ * Queda de um enlace ou nó em down e retorno em up. Com repeat > 1, a falha se repete (flapping):
+ * o elemento fica ativo por interval depois de cada retorno e cai de novo pelo mesmo tempo.
+ */
+struct FailureDescription {
+  FailureTarget target;
+  uint32_t element; //!< Índice do enlace ou do nó, conforme o alvo
+  Time down;
+  Time up;
+  uint32_t repeat;
+  Time interval;
+};
+
+/**
+ * Falhas aleatórias entre start e stop, com tempo até a falha e tempo de reparo exponenciais de
+ * médias mtbf e mttr.
+ */
+struct RandomFailureDescription {
+  FailureTarget target;
+  uint32_t element; //!< Índice do enlace ou do nó; ignorado com ALL_LINKS
+  Time mtbf;
+  Time mttr;
+  Time start;
+  Time stop;
+};
+
+/**
+ * Descrição de uma topologia: nós, enlaces e falhas programadas ou aleatórias.
+ *
+ * Os elementos são guardados em vetores contíguos, indexados na ordem de inserção; os enlaces
+ * são criados e endereçados nessa ordem, o que define os índices das interfaces de cada nó.
+ */
+class TopologyDescription {
+public:
+  static const uint32_t NOT_FOUND = UINT32_MAX;
+
+  void Reserve (size_t nodes, size_t links);
+
+  /**
+   * @return Índice do nó, ou NOT_FOUND se já existe um nó com o mesmo nome.
+   */
+  uint32_t AddNode (const std::string& name, bool router, double x = 0, double y = 0);
+
+  uint32_t AddLink (uint32_t node1, uint32_t node2, ChannelType type, uint64_t dataRate, Time delay, uint8_t cost = 1);
+
+  void AddFailure (uint32_t link, Time down, Time up);
+
+  void AddFailure (const FailureDescription& failure);
+
+  void AddRandomFailure (const RandomFailureDescription& failure);
+
+  /**
+   * Move a primeira queda e o primeiro retorno de todas as falhas programadas para os instantes
+   * informados. As falhas aleatórias não são alteradas.
+   */
+  void SetFailureTimes (Time down, Time up);
+
+  void ClearFailures ();
+
+  uint32_t FindNode (const std::string& name) const;
+
+  /**
+   * @return Índice do primeiro enlace entre os dois nós, ou NOT_FOUND. Usa um índice hash pelo par
+   *         de nós, mantido em AddLink, então a consulta não percorre os enlaces.
+   */
+  uint32_t FindLink (uint32_t node1, uint32_t node2) const;
+
+  const std::vector<NodeDescription>& GetNodes () const {
+    return m_nodes;
+  }
+
+  const std::vector<LinkDescription>& GetLinks () const {
+    return m_links;
+  }
+
+  const std::vector<FailureDescription>& GetFailures () const {
+    return m_failures;
+  }
+
+  const std::vector<RandomFailureDescription>& GetRandomFailures () const {
+    return m_randomFailures;
+  }
+
+private:
+  static uint64_t LinkKey (uint32_t node1, uint32_t node2) {
+    return node1 < node2 ? (static_cast<uint64_t> (node1) << 32) | node2 : (static_cast<uint64_t> (node2) << 32) | node1;
+  }
+
+  std::vector<NodeDescription> m_nodes;
+  std::vector<LinkDescription> m_links;
+  std::vector<FailureDescription> m_failures;
+  std::vector<RandomFailureDescription> m_randomFailures;
+  std::unordered_map<std::string, uint32_t> m_nodeIndex;
+  std::unordered_map<uint64_t, uint32_t> m_linkIndex; //!< Primeiro enlace de cada par (menor, maior índice)
+};
+
+} // namespace ns3
+
+#endif /* TOPOLOGY_DESCRIPTION_H */
@@ -0,0 +1,243 @@
+#include "topology-generator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+
+namespace {
+
+/** Lado da área usada para posicionar os roteadores no NetAnim */
+const double AREA_SIZE = 100.0;
+
+uint8_t DrawCost (const GeneratorConfig& config) {
+  if (config.cost == nullptr) {
+    return 1;
+  }
+  double cost = std::round (config.cost->GetValue ());
+  return static_cast<uint8_t> (std::min (15.0, std::max (1.0, cost)));
+}
+
+void AddRouter (TopologyDescription& topology, uint32_t index, double x, double y) {
+  topology.AddNode ("Router" + std::to_string (index + 1), true, x, y);
+}
+
+void AddRouterLink (const GeneratorConfig& config, TopologyDescription& topology, uint32_t node1, uint32_t node2) {
+  topology.AddLink (node1, node2, config.type, config.dataRate, config.delay, DrawCost (config));
+}
+
+/**
+ * Agenda a falha no primeiro enlace do roteador 0 e liga os hosts T (ao roteador 0) e R (ao receiverRouter).
+ */
+void AddHosts (const GeneratorConfig& config, TopologyDescription& topology, uint32_t receiverRouter) {
+  if (config.failureDown > Time (0)) {
+    const auto& links = topology.GetLinks ();
+    for (uint32_t i = 0; i < links.size (); ++i) {
+      if (links[i].node1 == 0 || links[i].node2 == 0) {
+        topology.AddFailure (i, config.failureDown, config.failureUp);
+        break;
+      }
+    }
+  }
+
+  const NodeDescription sender = topology.GetNodes ()[0];
+  const NodeDescription receiver = topology.GetNodes ()[receiverRouter];
+  uint32_t t = topology.AddNode ("T", false, sender.x - 5.0, sender.y);
+  uint32_t r = topology.AddNode ("R", false, receiver.x + 5.0, receiver.y);
+  topology.AddLink (t, 0, config.type, config.dataRate, config.delay);
+  topology.AddLink (receiverRouter, r, config.type, config.dataRate, config.delay);
+}
+
+/**
+ * Union-find com compressão de caminho por halving, usado para garantir a conectividade.
+ */
+uint32_t FindRoot (std::vector<uint32_t>& parent, uint32_t node) {
+  while (parent[node] != node) {
+    parent[node] = parent[parent[node]];
+    node = parent[node];
+  }
+  return node;
+}
+
+} // namespace
+
+bool GenerateTopology (const std::string& generator, const GeneratorConfig& config, TopologyDescription& topology) {
+  if (config.routers < 2) {
+    return false;
+  }
+  if (generator == "grid") {
+    GenerateGrid (config, topology);
+  } else if (generator == "ring") {
+    GenerateRing (config, topology);
+  } else if (generator == "waxman") {
+    GenerateWaxman (config, topology);
+  } else if (generator == "ba") {
+    GenerateBarabasiAlbert (config, topology);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+void GenerateGrid (const GeneratorConfig& config, TopologyDescription& topology) {
+  const uint32_t n = config.routers;
+  const uint32_t columns = static_cast<uint32_t> (std::ceil (std::sqrt (n)));
+  const double spacing = AREA_SIZE / columns;
+  topology.Reserve (n + 2, 2 * n + 2);
+
+  for (uint32_t i = 0; i < n; ++i) {
+    AddRouter (topology, i, (i % columns + 0.5) * spacing, (i / columns + 0.5) * spacing);
+  }
+  for (uint32_t i = 0; i < n; ++i) {
+    if (i % columns + 1 < columns && i + 1 < n) {
+      AddRouterLink (config, topology, i, i + 1);
+    }
+    if (i + columns < n) {
+      AddRouterLink (config, topology, i, i + columns);
+    }
+  }
+  AddHosts (config, topology, n - 1);
+}
+
+void GenerateRing (const GeneratorConfig& config, TopologyDescription& topology) {
+  const uint32_t n = config.routers;
+  topology.Reserve (n + 2, n + 2);
+
+  const double radius = AREA_SIZE * 0.4;
+  for (uint32_t i = 0; i < n; ++i) {
+    double angle = 2 * M_PI * i / n;
+    AddRouter (topology, i, AREA_SIZE / 2 + radius * std::cos (angle), AREA_SIZE / 2 + radius * std::sin (angle));
+  }
+  // Com dois roteadores o anel é um único enlace
+  for (uint32_t i = 0; i < (n == 2 ? 1 : n); ++i) {
+    AddRouterLink (config, topology, i, (i + 1) % n);
+  }
+  AddHosts (config, topology, n / 2);
+}
+
+void GenerateWaxman (const GeneratorConfig& config, TopologyDescription& topology) {
+  const uint32_t n = config.routers;
+  const uint64_t expectedLinks = static_cast<uint64_t> (config.degree * n / 2);
+  topology.Reserve (n + 2, expectedLinks + expectedLinks / 8 + n / 8 + 2);
+
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  std::vector<double> x (n), y (n);
+  for (uint32_t i = 0; i < n; ++i) {
+    x[i] = random->GetValue (0, AREA_SIZE);
+    y[i] = random->GetValue (0, AREA_SIZE);
+    AddRouter (topology, i, x[i], y[i]);
+  }
+
+  const double range = config.waxmanBeta * AREA_SIZE * std::sqrt (2.0);
+  auto probability = [&] (uint32_t u, uint32_t v) {
+    return std::exp (-std::hypot (x[u] - x[v], y[u] - y[v]) / range);
+  };
+
+  // Estima a média de exp(-d / (beta * L)) em uma amostra de pares para calcular o alpha que
+  // resulta no grau médio desejado: E = alpha * média * N * (N - 1) / 2
+  const uint32_t samples = 1000;
+  double mean = 0;
+  for (uint32_t i = 0; i < samples; ++i) {
+    uint32_t u = random->GetInteger (0, n - 1);
+    uint32_t v = random->GetInteger (0, n - 2);
+    mean += probability (u, v >= u ? v + 1 : v);
+  }
+  mean /= samples;
+  const double alpha = std::min (1.0, config.degree / ((n - 1) * mean));
+
+  // Percorre os pares (u, v), u < v, saltando um número geométrico de pares entre candidatos:
+  // cada par vira candidato com probabilidade alpha e é aceito com probabilidade exp(-d / (beta * L))
+  std::vector<uint32_t> parent (n);
+  for (uint32_t i = 0; i < n; ++i) {
+    parent[i] = i;
+  }
+  const double logSkip = alpha < 1.0 ? std::log (1.0 - alpha) : 0.0;
+  uint64_t u = 0;
+  uint64_t v = 0;
+  while (true) {
+    double skip = logSkip < 0.0 ? std::floor (std::log (1.0 - random->GetValue ()) / logSkip) : 0.0;
+    if (skip >= static_cast<double> (n) * n) {
+      break;
+    }
+    v += 1 + static_cast<uint64_t> (skip);
+    while (v >= n && u < n - 1) {
+      uint64_t overflow = v - n;
+      ++u;
+      v = u + 1 + overflow;
+    }
+    if (u >= n - 1) {
+      break;
+    }
+    if (random->GetValue () < probability (u, v)) {
+      AddRouterLink (config, topology, u, v);
+      parent[FindRoot (parent, u)] = FindRoot (parent, v);
+    }
+  }
+
+  // Liga cada componente desconexa ao roteador anterior, que já está na componente do roteador 0
+  for (uint32_t i = 1; i < n; ++i) {
+    uint32_t root = FindRoot (parent, i);
+    uint32_t mainRoot = FindRoot (parent, 0);
+    if (root != mainRoot) {
+      AddRouterLink (config, topology, i - 1, i);
+      parent[root] = mainRoot;
+    }
+  }
+
+  uint32_t farthest = 0;
+  double farthestDistance = 0;
+  for (uint32_t i = 1; i < n; ++i) {
+    double distance = std::hypot (x[i] - x[0], y[i] - y[0]);
+    if (distance > farthestDistance) {
+      farthest = i;
+      farthestDistance = distance;
+    }
+  }
+  AddHosts (config, topology, farthest);
+}
+
+void GenerateBarabasiAlbert (const GeneratorConfig& config, TopologyDescription& topology) {
+  const uint32_t n = config.routers;
+  const uint32_t m = std::max (1u, static_cast<uint32_t> (std::round (config.degree / 2)));
+  const uint32_t initial = std::min (n, m + 1);
+  const uint64_t links = static_cast<uint64_t> (initial) * (initial - 1) / 2 + static_cast<uint64_t> (n - initial) * m;
+  topology.Reserve (n + 2, links + 2);
+
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  for (uint32_t i = 0; i < n; ++i) {
+    AddRouter (topology, i, random->GetValue (0, AREA_SIZE), random->GetValue (0, AREA_SIZE));
+  }
+
+  // Cada enlace insere as duas pontas nesta lista; sortear uma posição escolhe um roteador
+  // com probabilidade proporcional ao seu grau
+  std::vector<uint32_t> endpoints;
+  endpoints.reserve (2 * links);
+  for (uint32_t i = 0; i < initial; ++i) {
+    for (uint32_t j = i + 1; j < initial; ++j) {
+      AddRouterLink (config, topology, i, j);
+      endpoints.push_back (i);
+      endpoints.push_back (j);
+    }
+  }
+
+  std::vector<uint32_t> targets;
+  targets.reserve (m);
+  for (uint32_t i = initial; i < n; ++i) {
+    targets.clear ();
+    const uint32_t lastEndpoint = endpoints.size () - 1;
+    while (targets.size () < m) {
+      uint32_t target = endpoints[random->GetInteger (0, lastEndpoint)];
+      if (std::find (targets.begin (), targets.end (), target) == targets.end ()) {
+        targets.push_back (target);
+      }
+    }
+    for (uint32_t target : targets) {
+      AddRouterLink (config, topology, target, i);
+      endpoints.push_back (target);
+      endpoints.push_back (i);
+    }
+  }
+  AddHosts (config, topology, n - 1);
+}
+
+} // namespace ns3
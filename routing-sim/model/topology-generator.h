@@ -0,0 +1,70 @@
+#ifndef TOPOLOGY_GENERATOR_H
+#define TOPOLOGY_GENERATOR_H
+
+#include "topology-description.h"
+
+#include "ns3/nstime.h"
+#include "ns3/random-variable-stream.h"
+
+#include <string>
+
+namespace ns3 {
+
+/**
+ * Parâmetros dos geradores de topologia.
+ */
+struct GeneratorConfig {
+  uint32_t routers = 100;
+  double degree = 4;        //!< Grau médio desejado (Waxman e Barabási–Albert)
+  double waxmanBeta = 0.1;  //!< Alcance das arestas no modelo de Waxman, relativo à diagonal da área
+  ChannelType type = ChannelType::POINT_TO_POINT;
+  uint64_t dataRate = 5000000;
+  Time delay = MilliSeconds (2);
+  Ptr<RandomVariableStream> cost; //!< Custo RIP dos enlaces entre roteadores, arredondado para 1 a 15 (1 se nulo)
+  Time failureDown = Seconds (100); //!< Queda do primeiro enlace entre roteadores do transmissor (zero desabilita)
+  Time failureUp = Seconds (200);
+};
+
+/**
+ * Gera uma topologia sintética com config.routers roteadores, no formato usado pelo TopologyBuilder.
+ *
+ * Além dos roteadores (Router1 a RouterN), são criados os hosts T, ligado ao primeiro roteador,
+ * e R, ligado a um roteador distante dele. Os sorteios usam os fluxos aleatórios do ns-3, então a
+ * topologia muda com RngRun. Os geradores reservam os vetores de antemão e executam em O(N + E),
+ * exceto o de Waxman (ver GenerateWaxman).
+ *
+ * @param generator grid, ring, waxman ou ba.
+ * @return false se o gerador é desconhecido ou a topologia teria menos de dois roteadores.
+ */
+bool GenerateTopology (const std::string& generator, const GeneratorConfig& config, TopologyDescription& topology);
+
+/**
+ * Grade aproximadamente quadrada, com cada roteador ligado aos vizinhos da direita e de baixo.
+ */
+void GenerateGrid (const GeneratorConfig& config, TopologyDescription& topology);
+
+/**
+ * Anel com cada roteador ligado ao seguinte.
+ */
+void GenerateRing (const GeneratorConfig& config, TopologyDescription& topology);
+
+/**
+ * Modelo de Waxman: roteadores em posições aleatórias, ligados com probabilidade
+ * alpha * exp(-d / (beta * L)), onde L é a diagonal da área. O alpha é calculado para obter o
+ * grau médio desejado a partir de uma amostra de 1000 pares. Os pares candidatos são sorteados
+ * com saltos geométricos e cada um é aceito com probabilidade exp(-d / (beta * L)), então o custo
+ * é O(N + E / m), onde m é a probabilidade média de aceitação, e não proporcional ao número de
+ * pares. Com beta pequeno, m é pequeno e há muito mais candidatos do que enlaces. Componentes
+ * desconexas são ligadas à componente do primeiro roteador.
+ */
+void GenerateWaxman (const GeneratorConfig& config, TopologyDescription& topology);
+
+/**
+ * Modelo de Barabási–Albert: cada roteador novo se liga a degree / 2 roteadores existentes,
+ * escolhidos com probabilidade proporcional ao grau.
+ */
+void GenerateBarabasiAlbert (const GeneratorConfig& config, TopologyDescription& topology);
+
+} // namespace ns3
+
+#endif /* TOPOLOGY_GENERATOR_H */
@@ -0,0 +1,302 @@
+#include "topology-partitioner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <queue>
+#include <utility>
+
+namespace ns3 {
+
+static const uint32_t UNASSIGNED = UINT32_MAX;
+
+/**
+ * Desequilíbrio admitido entre as partições durante o refinamento.
+ */
+static const double MAX_IMBALANCE = 0.05;
+
+/**
+ * Número máximo de passadas do refinamento.
+ */
+static const uint32_t REFINEMENT_PASSES = 8;
+
+TopologyPartitioner::TopologyPartitioner (const TopologyDescription& topology)
+  : m_topology (topology),
+    m_traffic (topology.GetLinks ().size (), 0.0),
+    m_minLookahead (Time (0)) {
+}
+
+void TopologyPartitioner::Pin (uint32_t node) {
+  m_pinned.push_back (node);
+}
+
+void TopologyPartitioner::SetMinLookahead (Time lookahead) {
+  m_minLookahead = lookahead;
+}
+
+void TopologyPartitioner::AddTraffic (uint32_t source, uint32_t destination, double weight) {
+  const auto& links = m_topology.GetLinks ();
+  const uint32_t n = m_topology.GetNodes ().size ();
+  if (source >= n || destination >= n) {
+    return;
+  }
+
+  // Enlaces de cada nó em formato CSR
+  std::vector<uint32_t> offsets (n + 1, 0);
+  for (const auto& link : links) {
+    ++offsets[link.node1 + 1];
+    ++offsets[link.node2 + 1];
+  }
+  std::partial_sum (offsets.begin (), offsets.end (), offsets.begin ());
+  std::vector<uint32_t> incident (offsets[n]);
+  std::vector<uint32_t> cursor (offsets.begin (), offsets.end () - 1);
+  for (uint32_t i = 0; i < links.size (); ++i) {
+    incident[cursor[links[i].node1]++] = i;
+    incident[cursor[links[i].node2]++] = i;
+  }
+
+  // Busca em largura a partir da origem, guardando o enlace pelo qual cada nó foi alcançado
+  std::vector<uint32_t> via (n, UNASSIGNED);
+  std::vector<uint32_t> queue = {source};
+  via[source] = links.size ();
+  for (size_t head = 0; head < queue.size () && via[destination] == UNASSIGNED; ++head) {
+    uint32_t node = queue[head];
+    for (uint32_t e = offsets[node]; e < offsets[node + 1]; ++e) {
+      const auto& link = links[incident[e]];
+      uint32_t neighbor = link.node1 == node ? link.node2 : link.node1;
+      if (via[neighbor] == UNASSIGNED) {
+        via[neighbor] = incident[e];
+        queue.push_back (neighbor);
+      }
+    }
+  }
+  if (via[destination] == UNASSIGNED) {
+    return;
+  }
+  for (uint32_t node = destination; node != source;) {
+    const auto& link = links[via[node]];
+    m_traffic[via[node]] += weight;
+    node = link.node1 == node ? link.node2 : link.node1;
+  }
+}
+
+bool TopologyPartitioner::IsCuttable (uint32_t link) const {
+  const auto& description = m_topology.GetLinks ()[link];
+  return description.type == ChannelType::POINT_TO_POINT && !description.delay.IsZero ()
+         && description.delay >= m_minLookahead;
+}
+
+double TopologyPartitioner::GetWeight (uint32_t link, double maxDelay) const {
+  return maxDelay / m_topology.GetLinks ()[link].delay.GetDouble () * (1 + m_traffic[link]);
+}
+
+static uint32_t FindRoot (std::vector<uint32_t>& parent, uint32_t node) {
+  while (parent[node] != node) {
+    parent[node] = parent[parent[node]];
+    node = parent[node];
+  }
+  return node;
+}
+
+std::vector<uint32_t> TopologyPartitioner::Partition (uint32_t parts) const {
+  const auto& links = m_topology.GetLinks ();
+  const uint32_t n = m_topology.GetNodes ().size ();
+  std::vector<uint32_t> partition (n, 0);
+  if (parts <= 1 || n == 0) {
+    return partition;
+  }
+
+  // Nós ligados por enlaces que não podem ser cortados formam uma unidade
+  std::vector<uint32_t> parent (n);
+  std::iota (parent.begin (), parent.end (), 0);
+  double maxDelay = 0;
+  for (uint32_t i = 0; i < links.size (); ++i) {
+    if (IsCuttable (i)) {
+      maxDelay = std::max (maxDelay, links[i].delay.GetDouble ());
+    } else {
+      parent[FindRoot (parent, links[i].node1)] = FindRoot (parent, links[i].node2);
+    }
+  }
+  std::vector<uint32_t> unit (n, UNASSIGNED);
+  std::vector<uint32_t> unitSize;
+  for (uint32_t i = 0; i < n; ++i) {
+    uint32_t root = FindRoot (parent, i);
+    if (unit[root] == UNASSIGNED) {
+      unit[root] = unitSize.size ();
+      unitSize.push_back (0);
+    }
+    unit[i] = unit[root];
+    ++unitSize[unit[i]];
+  }
+  const uint32_t units = unitSize.size ();
+
+  // Grafo das unidades em formato CSR, com o peso de cada enlace cortável
+  std::vector<uint32_t> offsets (units + 1, 0);
+  for (const auto& link : links) {
+    if (unit[link.node1] != unit[link.node2]) {
+      ++offsets[unit[link.node1] + 1];
+      ++offsets[unit[link.node2] + 1];
+    }
+  }
+  std::partial_sum (offsets.begin (), offsets.end (), offsets.begin ());
+  std::vector<std::pair<uint32_t, double>> edges (offsets[units]);
+  std::vector<uint32_t> cursor (offsets.begin (), offsets.end () - 1);
+  for (uint32_t i = 0; i < links.size (); ++i) {
+    uint32_t u = unit[links[i].node1];
+    uint32_t v = unit[links[i].node2];
+    if (u != v) {
+      double weight = GetWeight (i, maxDelay);
+      edges[cursor[u]++] = {v, weight};
+      edges[cursor[v]++] = {u, weight};
+    }
+  }
+
+  std::vector<uint32_t> assigned (units, UNASSIGNED);
+  std::vector<bool> pinned (units, false);
+  for (uint32_t node : m_pinned) {
+    if (node < n) {
+      pinned[unit[node]] = true;
+    }
+  }
+
+  // Crescimento das partições
+  std::vector<double> gain (units);
+  uint32_t remainingNodes = n;
+  uint32_t nextSeed = 0;
+
+  for (uint32_t part = 0; part + 1 < parts; ++part) {
+    const uint32_t target = (remainingNodes + (parts - part) - 1) / (parts - part);
+    std::fill (gain.begin (), gain.end (), 0.0);
+    std::priority_queue<std::pair<double, uint32_t>> frontier;
+    uint32_t size = 0;
+
+    auto absorb = [&] (uint32_t u) {
+      assigned[u] = part;
+      size += unitSize[u];
+      for (uint32_t e = offsets[u]; e < offsets[u + 1]; ++e) {
+        uint32_t v = edges[e].first;
+        if (assigned[v] == UNASSIGNED) {
+          gain[v] += edges[e].second;
+          frontier.emplace (gain[v], v);
+        }
+      }
+    };
+
+    if (part == 0) {
+      for (uint32_t u = 0; u < units; ++u) {
+        if (pinned[u]) {
+          absorb (u);
+        }
+      }
+    }
+
+    while (size < target) {
+      // Entradas antigas da fila (unidade já absorvida ou ganho desatualizado) são descartadas
+      while (!frontier.empty ()
+             && (assigned[frontier.top ().second] != UNASSIGNED || frontier.top ().first != gain[frontier.top ().second])) {
+        frontier.pop ();
+      }
+      if (!frontier.empty ()) {
+        uint32_t u = frontier.top ().second;
+        frontier.pop ();
+        absorb (u);
+        continue;
+      }
+      // Sem vizinhos livres (início da partição ou componente esgotado): nova semente
+      while (nextSeed < units && assigned[nextSeed] != UNASSIGNED) {
+        ++nextSeed;
+      }
+      if (nextSeed == units) {
+        break;
+      }
+      absorb (nextSeed);
+    }
+    remainingNodes -= std::min (size, remainingNodes);
+  }
+
+  std::vector<uint32_t> partSize (parts, 0);
+  for (uint32_t u = 0; u < units; ++u) {
+    if (assigned[u] == UNASSIGNED) {
+      assigned[u] = parts - 1;
+    }
+    partSize[assigned[u]] += unitSize[u];
+  }
+
+  // Refinamento: cada unidade da fronteira vai para a partição vizinha com a qual tem mais peso,
+  // se isso reduz o peso cortado e as duas partições continuam dentro do desequilíbrio admitido
+  const double average = static_cast<double> (n) / parts;
+  const uint32_t maxSize = std::ceil (average * (1 + MAX_IMBALANCE));
+  const uint32_t minSize = std::floor (average * (1 - MAX_IMBALANCE));
+  std::vector<double> connection (parts, 0.0);
+  std::vector<uint32_t> touched;
+  for (uint32_t pass = 0; pass < REFINEMENT_PASSES; ++pass) {
+    uint32_t moved = 0;
+    for (uint32_t u = 0; u < units; ++u) {
+      if (pinned[u]) {
+        continue;
+      }
+      for (uint32_t e = offsets[u]; e < offsets[u + 1]; ++e) {
+        uint32_t part = assigned[edges[e].first];
+        if (connection[part] == 0) {
+          touched.push_back (part);
+        }
+        connection[part] += edges[e].second;
+      }
+      const uint32_t from = assigned[u];
+      uint32_t best = from;
+      for (uint32_t part : touched) {
+        if (connection[part] > connection[best] && partSize[part] + unitSize[u] <= maxSize) {
+          best = part;
+        }
+      }
+      if (best != from && partSize[from] >= minSize + unitSize[u]) {
+        assigned[u] = best;
+        partSize[from] -= unitSize[u];
+        partSize[best] += unitSize[u];
+        ++moved;
+      }
+      for (uint32_t part : touched) {
+        connection[part] = 0;
+      }
+      touched.clear ();
+    }
+    if (moved == 0) {
+      break;
+    }
+  }
+
+  for (uint32_t i = 0; i < n; ++i) {
+    partition[i] = assigned[unit[i]];
+  }
+  return partition;
+}
+
+PartitionStats TopologyPartitioner::Evaluate (const std::vector<uint32_t>& partition, uint32_t parts) const {
+  const auto& links = m_topology.GetLinks ();
+  double maxDelay = 0;
+  for (uint32_t i = 0; i < links.size (); ++i) {
+    if (IsCuttable (i)) {
+      maxDelay = std::max (maxDelay, links[i].delay.GetDouble ());
+    }
+  }
+
+  PartitionStats stats;
+  stats.nodes.assign (parts, 0);
+  stats.lookahead = Time::Max ();
+  for (uint32_t part : partition) {
+    if (part < parts) {
+      ++stats.nodes[part];
+    }
+  }
+  for (uint32_t i = 0; i < links.size (); ++i) {
+    if (partition[links[i].node1] == partition[links[i].node2]) {
+      continue;
+    }
+    ++stats.cutLinks;
+    stats.cutWeight += IsCuttable (i) ? GetWeight (i, maxDelay) : 0;
+    stats.lookahead = std::min (stats.lookahead, links[i].delay);
+  }
+  return stats;
+}
+
+} // namespace ns3
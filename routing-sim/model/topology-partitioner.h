@@ -0,0 +1,85 @@
+#ifndef TOPOLOGY_PARTITIONER_H
+#define TOPOLOGY_PARTITIONER_H
+
+#include "topology-description.h"
+
+#include "ns3/nstime.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * Qualidade de uma divisão da topologia entre processos.
+ */
+struct PartitionStats {
+  std::vector<uint32_t> nodes; //!< Número de nós de cada partição
+  uint32_t cutLinks = 0;       //!< Enlaces entre partições diferentes
+  double cutWeight = 0;        //!< Soma dos pesos dos enlaces cortados
+  Time lookahead;              //!< Menor atraso entre os enlaces cortados (Time::Max () sem cortes)
+};
+
+/**
+ * Divide os nós de uma topologia entre os processos da simulação distribuída (systemId do nó).
+ *
+ * O simulador distribuído só avança cada processo até o instante em que pode receber um pacote
+ * de outro, então o menor atraso entre os enlaces cortados (lookahead) limita o paralelismo:
+ * cortar um enlace CSMA de alguns microssegundos faz os processos avançarem quase em sincronia.
+ * Enlaces CSMA, que não podem ligar processos diferentes no ns-3, e enlaces com atraso abaixo do
+ * lookahead mínimo nunca são cortados: os nós ligados por eles formam uma unidade indivisível.
+ *
+ * O peso de cada enlace é o atraso do enlace mais lento dividido pelo seu atraso, multiplicado
+ * por 1 mais o tráfego esperado nele (AddTraffic). As partições crescem a partir de uma semente,
+ * absorvendo sempre a unidade mais fortemente ligada à partição, até atingir a sua parte dos nós;
+ * depois, as unidades da fronteira são movidas para a partição vizinha com a qual têm mais peso,
+ * enquanto isso reduzir o peso cortado sem desequilibrar as partições.
+ */
+class TopologyPartitioner {
+public:
+  /**
+   * @param topology Descrição da topologia, que deve existir enquanto o particionador for usado.
+   */
+  TopologyPartitioner (const TopologyDescription& topology);
+
+  /**
+   * Fixa o nó na partição 0, por exemplo a origem e o destino do tráfego, para que as
+   * estatísticas de fluxo fiquem em um único processo.
+   */
+  void Pin (uint32_t node);
+
+  /**
+   * Soma weight ao tráfego esperado dos enlaces do menor caminho (em saltos) entre os dois nós.
+   */
+  void AddTraffic (uint32_t source, uint32_t destination, double weight = 1);
+
+  /**
+   * Enlaces ponto a ponto com atraso menor que lookahead não são cortados. O padrão é zero,
+   * que só impede o corte de enlaces sem atraso.
+   */
+  void SetMinLookahead (Time lookahead);
+
+  /**
+   * @param parts Número de partições (processos).
+   * @return Partição de cada nó, na ordem da descrição.
+   */
+  std::vector<uint32_t> Partition (uint32_t parts) const;
+
+  /**
+   * Calcula o tamanho das partições, os enlaces cortados e o lookahead de uma divisão.
+   */
+  PartitionStats Evaluate (const std::vector<uint32_t>& partition, uint32_t parts) const;
+
+private:
+  bool IsCuttable (uint32_t link) const;
+  double GetWeight (uint32_t link, double maxDelay) const;
+
+  const TopologyDescription& m_topology;
+  std::vector<uint32_t> m_pinned;
+  std::vector<double> m_traffic; //!< Tráfego esperado em cada enlace
+  Time m_minLookahead;
+};
+
+} // namespace ns3
+
+#endif /* TOPOLOGY_PARTITIONER_H */
@@ -0,0 +1,280 @@
+#include "ns3/adjacency-index.h"
+#include "ns3/ipv4.h"
+#include "ns3/latency-histogram.h"
+#include "ns3/running-statistics.h"
+#include "ns3/simulator.h"
+#include "ns3/subnet-allocator.h"
+#include "ns3/test.h"
+#include "ns3/topology-builder.h"
+#include "ns3/topology-description.h"
+#include "ns3/topology-loader.h"
+
+#include <cmath>
+#include <fstream>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * Quantis da distribuição t de Student contra valores de referência (tabelas e R qt ()).
+ */
+class StudentTQuantileTestCase : public TestCase {
+public:
+  StudentTQuantileTestCase ();
+
+private:
+  void DoRun () override;
+};
+
+StudentTQuantileTestCase::StudentTQuantileTestCase ()
+  : TestCase ("Quantis da distribuição t de Student") {
+}
+
+void StudentTQuantileTestCase::DoRun () {
+  struct Reference {
+    double probability;
+    double degreesOfFreedom;
+    double quantile;
+  };
+  const Reference references[] = {
+    {0.975, 1, 12.706204736}, {0.975, 2, 4.302652730}, {0.975, 5, 2.570581836},
+    {0.975, 10, 2.228138852}, {0.975, 30, 2.042272456}, {0.975, 100, 1.983971519},
+    {0.975, 1000, 1.962339081}, {0.995, 1, 63.656741163}, {0.995, 2, 9.924843201},
+    {0.95, 10, 1.812461123}, {0.025, 5, -2.570581836}};
+  for (const auto& reference : references) {
+    NS_TEST_EXPECT_MSG_EQ_TOL (StudentTQuantile (reference.probability, reference.degreesOfFreedom),
+                               reference.quantile, 1e-6,
+                               "t(" << reference.probability << ", " << reference.degreesOfFreedom << ")");
+  }
+  NS_TEST_EXPECT_MSG_EQ (StudentTQuantile (0.5, 7), 0, "Mediana da distribuição t");
+  NS_TEST_EXPECT_MSG_EQ (std::isinf (StudentTQuantile (1, 7)), true, "Quantil 1");
+}
+
+/**
+ * Cada valor gravado no histograma volta como o ponto médio da sua faixa, com o erro relativo
+ * garantido pela precisão.
+ */
+class LatencyHistogramTestCase : public TestCase {
+public:
+  LatencyHistogramTestCase ();
+
+private:
+  void DoRun () override;
+};
+
+LatencyHistogramTestCase::LatencyHistogramTestCase ()
+  : TestCase ("Ida e volta entre valores e faixas do LatencyHistogram") {
+}
+
+void LatencyHistogramTestCase::DoRun () {
+  const uint8_t precision = 5;
+  const int64_t maxValue = int64_t (1) << 40;
+  for (int64_t value = 0; value < maxValue; value = value < 64 ? value + 1 : value * 3 / 2 + 7) {
+    // Os extremos impedem que a mediana seja limitada pelo mínimo ou pelo máximo observado
+    LatencyHistogram histogram (precision);
+    histogram.Record (0);
+    histogram.Record (maxValue);
+    for (int i = 0; i < 10; ++i) {
+      histogram.Record (value);
+    }
+    int64_t median = histogram.GetPercentile (0.5);
+    if (value < (int64_t (1) << precision)) {
+      NS_TEST_EXPECT_MSG_EQ (median, value, "Faixas de largura 1 abaixo de 2^precision");
+    } else {
+      NS_TEST_EXPECT_MSG_EQ_TOL (median, value, std::ldexp (double (value), -precision),
+                                 "Erro relativo do valor " << value);
+    }
+  }
+
+  LatencyHistogram histogram (precision);
+  histogram.Record (1000);
+  histogram.Record (3000);
+  NS_TEST_EXPECT_MSG_EQ (histogram.GetMin (), 1000, "Mínimo exato");
+  NS_TEST_EXPECT_MSG_EQ (histogram.GetMax (), 3000, "Máximo exato");
+  NS_TEST_EXPECT_MSG_EQ (histogram.GetPercentile (1), 3000, "O percentil é limitado ao máximo");
+}
+
+/**
+ * Endereços de rede e de host das sub-redes /30 e /31 (RFC 3021).
+ */
+class SubnetAllocatorTestCase : public TestCase {
+public:
+  SubnetAllocatorTestCase ();
+
+private:
+  void DoRun () override;
+};
+
+SubnetAllocatorTestCase::SubnetAllocatorTestCase ()
+  : TestCase ("Endereçamento /30 e /31 do SubnetAllocator") {
+}
+
+void SubnetAllocatorTestCase::DoRun () {
+  SubnetAllocator subnets;
+  NS_TEST_ASSERT_MSG_EQ (subnets.SetPool ("10.0.0.0/8", 30), true, "Bloco /8 com sub-redes /30");
+  subnets.Allocate ();
+  uint32_t subnet = subnets.Allocate ();
+  NS_TEST_EXPECT_MSG_EQ (subnet, 1u, "Índice da segunda sub-rede");
+  NS_TEST_EXPECT_MSG_EQ (subnets.GetNetwork (subnet), Ipv4Address ("10.0.0.4"), "Rede /30");
+  NS_TEST_EXPECT_MSG_EQ (subnets.GetMask (), Ipv4Mask ("255.255.255.252"), "Máscara /30");
+  NS_TEST_EXPECT_MSG_EQ (subnets.GetHostCount (), 2u, "Hosts de uma /30");
+  NS_TEST_EXPECT_MSG_EQ (subnets.GetHostAddress (subnet, 0), Ipv4Address ("10.0.0.5"), "Primeiro host /30");
+  NS_TEST_EXPECT_MSG_EQ (subnets.GetHostAddress (subnet, 1), Ipv4Address ("10.0.0.6"), "Segundo host /30");
+  NS_TEST_EXPECT_MSG_EQ (subnets.FindSubnet (Ipv4Address ("10.0.0.7")), 1u, "Broadcast da segunda /30");
+  NS_TEST_EXPECT_MSG_EQ (subnets.FindSubnet (Ipv4Address ("10.0.0.8")), SubnetAllocator::NOT_AVAILABLE,
+                         "Endereço fora das sub-redes alocadas");
+
+  NS_TEST_ASSERT_MSG_EQ (subnets.SetPool ("10.0.0.0/30", 31), true, "Bloco /30 com sub-redes /31");
+  subnets.Allocate ();
+  subnet = subnets.Allocate ();
+  NS_TEST_EXPECT_MSG_EQ (subnets.GetNetwork (subnet), Ipv4Address ("10.0.0.2"), "Rede /31");
+  NS_TEST_EXPECT_MSG_EQ (subnets.GetMask (), Ipv4Mask ("255.255.255.254"), "Máscara /31");
+  NS_TEST_EXPECT_MSG_EQ (subnets.GetHostCount (), 2u, "Hosts de uma /31");
+  NS_TEST_EXPECT_MSG_EQ (subnets.GetHostAddress (subnet, 0), Ipv4Address ("10.0.0.2"), "Primeiro host /31");
+  NS_TEST_EXPECT_MSG_EQ (subnets.GetHostAddress (subnet, 1), Ipv4Address ("10.0.0.3"), "Segundo host /31");
+  NS_TEST_EXPECT_MSG_EQ (subnets.Allocate (), SubnetAllocator::NOT_AVAILABLE, "Bloco esgotado");
+
+  NS_TEST_EXPECT_MSG_EQ (subnets.SetPool ("10.0.0.0/24", 16), false, "Prefixo maior que o bloco");
+  NS_TEST_EXPECT_MSG_EQ (subnets.SetPool ("10.0.0.0/8", 32), false, "Prefixo /32");
+}
+
+/**
+ * As interfaces previstas pelo AdjacencyIndex são as devolvidas pelo Ipv4::AddInterface.
+ */
+class InterfacePredictionTestCase : public TestCase {
+public:
+  InterfacePredictionTestCase ();
+
+private:
+  void DoRun () override;
+};
+
+InterfacePredictionTestCase::InterfacePredictionTestCase ()
+  : TestCase ("Interfaces previstas pelo AdjacencyIndex") {
+}
+
+void InterfacePredictionTestCase::DoRun () {
+  // As interfaces informadas explicitamente também avançam a previsão
+  AdjacencyIndex index;
+  index.AddLink (0, 1, 3, 1);
+  index.AddLink (0, 2);
+  index.Finalize ();
+  NS_TEST_EXPECT_MSG_EQ (index.GetInterface (0, 1), 3u, "Interface explícita");
+  NS_TEST_EXPECT_MSG_EQ (index.GetInterface (0, 2), 4u, "Interface prevista depois da explícita");
+  NS_TEST_EXPECT_MSG_EQ (index.GetInterface (2, 0), 1u, "Primeira interface prevista");
+  NS_TEST_EXPECT_MSG_EQ (index.GetInterface (1, 2), AdjacencyIndex::NOT_FOUND, "Nós não vizinhos");
+
+  // Enlaces p2p e csma misturados, com um enlace paralelo e um host
+  TopologyDescription topology;
+  uint32_t a = topology.AddNode ("A", true);
+  uint32_t b = topology.AddNode ("B", true);
+  uint32_t c = topology.AddNode ("C", true);
+  uint32_t d = topology.AddNode ("D", false);
+  topology.AddLink (a, b, ChannelType::POINT_TO_POINT, 5000000, MilliSeconds (2));
+  topology.AddLink (b, c, ChannelType::CSMA, 100000000, NanoSeconds (6560));
+  topology.AddLink (c, a, ChannelType::POINT_TO_POINT, 5000000, MilliSeconds (2), 3);
+  topology.AddLink (a, b, ChannelType::CSMA, 100000000, NanoSeconds (6560), 2);
+  topology.AddLink (d, c, ChannelType::CSMA, 100000000, NanoSeconds (6560));
+
+  TopologyBuilder builder (topology);
+  SubnetAllocator subnets;
+  NS_TEST_ASSERT_MSG_EQ (builder.Build ("olsr", subnets), true, "Construção da topologia");
+  const AdjacencyIndex& adjacency = builder.GetAdjacency ();
+  for (uint32_t i = 0; i < topology.GetLinks ().size (); ++i) {
+    NetDeviceContainer devices = builder.GetLinkDevices (i);
+    const AdjacencyIndex::Link& link = adjacency.GetLink (i);
+    const uint32_t predicted[2] = {link.interface1, link.interface2};
+    for (uint32_t j = 0; j < 2; ++j) {
+      Ptr<Ipv4> ipv4 = devices.Get (j)->GetNode ()->GetObject<Ipv4> ();
+      NS_TEST_EXPECT_MSG_EQ (ipv4->GetInterfaceForDevice (devices.Get (j)), static_cast<int32_t> (predicted[j]),
+                             "Interface da ponta " << j << " do enlace " << i);
+    }
+  }
+  uint32_t nodeA = builder.GetNode (a)->GetId ();
+  uint32_t nodeB = builder.GetNode (b)->GetId ();
+  NS_TEST_EXPECT_MSG_EQ (adjacency.GetLinkId (nodeB, nodeA), 0u, "Primeiro enlace entre A e B");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * O LoadTopology rejeita linhas malformadas em vez de carregar uma topologia parcial.
+ */
+class TopologyLoaderTestCase : public TestCase {
+public:
+  TopologyLoaderTestCase ();
+
+private:
+  void DoRun () override;
+
+  /**
+   * Grava as declarações dos nós A e B seguidas da linha e carrega o arquivo.
+   */
+  bool Load (const std::string& line, TopologyDescription& topology);
+};
+
+TopologyLoaderTestCase::TopologyLoaderTestCase ()
+  : TestCase ("Linhas inválidas no LoadTopology") {
+}
+
+bool TopologyLoaderTestCase::Load (const std::string& line, TopologyDescription& topology) {
+  std::string fileName = CreateTempDirFilename ("topology.txt");
+  std::ofstream file (fileName);
+  file << "# Topologia de teste\n"
+       << "node A router 10 10\n"
+       << "node B router 20 20\n"
+       << line << "\n";
+  file.close ();
+  return LoadTopology (fileName, topology);
+}
+
+void TopologyLoaderTestCase::DoRun () {
+  TopologyDescription topology;
+  NS_TEST_ASSERT_MSG_EQ (Load ("link A B csma 100Mbps 6560ns 2  # comentário", topology), true, "Linha válida");
+  NS_TEST_EXPECT_MSG_EQ (topology.GetLinks ().size (), 1u, "Enlace carregado");
+  NS_TEST_EXPECT_MSG_EQ (topology.GetLinks ()[0].dataRate, 100000000u, "Taxa do enlace");
+  NS_TEST_EXPECT_MSG_EQ (topology.GetLinks ()[0].delay, NanoSeconds (6560), "Atraso do enlace");
+  NS_TEST_EXPECT_MSG_EQ (unsigned (topology.GetLinks ()[0].cost), 2u, "Custo do enlace");
+
+  const char* invalidLines[] = {
+    "link A B csma nanMbps 1ms",             // NaN
+    "link A B csma infMbps 1ms",             // Infinito
+    "link A B csma 1e30Gbps 1ms",            // Taxa fora do intervalo de uint64_t
+    "link A B csma 5Mbps 1e300s",            // Atraso fora do intervalo do Time
+    "link A B csma 5Mbps -1ms",              // Atraso negativo
+    "link A B csma 5Xbps 1ms",               // Unidade desconhecida
+    "link A B csma 5Mbps 1ms 16",            // Custo acima do máximo do RIP
+    "link A B csma 5Mbps 1ms 1.5",           // Custo fracionário
+    "link A B csma 5Mbps 1ms 1 2",           // Palavras demais para um enlace
+    "link A B wifi 5Mbps 1ms",               // Canal desconhecido
+    "link A C csma 5Mbps 1ms",               // Nó não declarado
+    "node C switch",                         // Tipo de nó desconhecido
+    "node C router 10",                      // Coordenada incompleta
+    "node A host",                           // Nome repetido
+    "route A B",                             // Palavra-chave desconhecida
+    "failure A B 100s 200s 1 2 3 4 5",       // Mais palavras do que qualquer declaração
+  };
+  for (const char* line : invalidLines) {
+    TopologyDescription invalid;
+    NS_TEST_EXPECT_MSG_EQ (Load (line, invalid), false, "Linha aceita: " << line);
+  }
+
+  TopologyDescription missing;
+  NS_TEST_EXPECT_MSG_EQ (LoadTopology (CreateTempDirFilename ("missing.txt"), missing), false, "Arquivo inexistente");
+}
+
+class RoutingSimTestSuite : public TestSuite {
+public:
+  RoutingSimTestSuite ();
+};
+
+RoutingSimTestSuite::RoutingSimTestSuite ()
+  : TestSuite ("routing-sim", UNIT) {
+  AddTestCase (new StudentTQuantileTestCase, TestCase::QUICK);
+  AddTestCase (new LatencyHistogramTestCase, TestCase::QUICK);
+  AddTestCase (new SubnetAllocatorTestCase, TestCase::QUICK);
+  AddTestCase (new InterfacePredictionTestCase, TestCase::QUICK);
+  AddTestCase (new TopologyLoaderTestCase, TestCase::QUICK);
+}
+
+static RoutingSimTestSuite g_routingSimTestSuite;
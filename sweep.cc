@@ -0,0 +1,321 @@
+// Executa o cenário topologia.cc para todas as combinações de topologia, protocolo de roteamento,
+// cenário de falha e semente (RngRun), em processos independentes distribuídos entre os núcleos
+// da máquina, e reúne os resultados de todas as execuções em uma tabela CSV.
+//
+// Cada execução grava a sua saída e os arquivos gerados em <workdir>/<n>/, e os tempos de convergência
+// e as estatísticas de fluxo de cada uma são lidos do resumo gravado com --summary. As execuções recebem
+// --captureFilter=none, pois a captura padrão do cenário gravaria todos os pacotes de todas elas; para
+// capturar, passe --captureFilter em --extra (ex.: --extra="--captureFilter=routing --snapLen=128").
+//
+// Topologias: arquivos (topologias/topologia1.txt) ou geradores no formato <gerador>:<roteadores> (waxman:1000).
+// Falhas: "file" mantém as falhas da topologia, "none" as remove e <queda>:<retorno> as move (100:200);
+// qualquer outro valor é um arquivo de falhas que substitui as da topologia (ver --failures do cenário).
+//
+// Com --precision, cada combinação é repetida com novas sementes até que a meia-largura do intervalo de
+// confiança da média dos tempos de convergência, da perda, do atraso e do jitter fique abaixo da fração
+// --precision da média (com no mínimo --minRuns, e pelo menos 3, e no máximo --runs sementes). As sementes de todas as
+// combinações são executadas em paralelo, e a média e o intervalo de cada métrica são gravados em --statistics.
+//
+// O executável do cenário deve ser passado em --program; como ele depende das bibliotecas do ns-3,
+// execute o sweep dentro do ./waf shell. Por exemplo:
+// ./waf shell
+// ./build/scratch/sweep --program=./build/scratch/topologia --topologies=topologias/topologia1.txt,topologias/topologia2.txt,waxman:1000 --protocols=rip,olsr --runs=10 --output=resultados/sweep.csv
+// ./build/scratch/sweep --program=./build/scratch/topologia --topologies=waxman:1000 --precision=0.05 --runs=50
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include "ns3/core-module.h"
+#include "ns3/routing-sim-module.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("Sweep");
+
+/**
+ * Separa uma lista de valores.
+ * @param text Valores separados por separator.
+ * @param separator Separador.
+ * @return Valores não vazios, na ordem da lista.
+ */
+std::vector<std::string> SplitList(const std::string &text, char separator) {
+  std::vector<std::string> values;
+  std::istringstream stream(text);
+  std::string value;
+  while (std::getline(stream, value, separator)) {
+    if (!value.empty()) {
+      values.push_back(value);
+    }
+  }
+  return values;
+}
+
+/**
+ * Execuções de uma combinação de topologia, protocolo e cenário de falha, com a média e a variância
+ * de cada valor do resumo acumuladas a cada execução concluída.
+ */
+struct Replication {
+  SweepJob job;             //!< Parâmetros e argumentos comuns a todas as sementes
+  uint32_t nextRun = 1;     //!< Próximo RngRun
+  uint32_t completed = 0;   //!< Execuções concluídas com sucesso
+  bool converged = false;   //!< Precisão alcançada
+  std::vector<std::pair<std::string, RunningStatistics>> statistics;
+};
+
+/**
+ * Indica se a precisão de uma métrica é usada para interromper as repetições.
+ */
+bool IsMonitored(const std::string &key) {
+  return key.compare(0, 12, "convergence_") == 0 || key == "loss_ratio" || key == "delay_s" || key == "jitter_s";
+}
+
+/**
+ * Verifica se a meia-largura do intervalo de confiança de todas as métricas monitoradas está
+ * abaixo da fração precision da média.
+ */
+bool IsPrecise(const Replication &replication, double precision, double confidence) {
+  for (const auto& entry : replication.statistics) {
+    if (IsMonitored(entry.first)
+        && entry.second.GetConfidenceHalfWidth(confidence) > precision * std::abs(entry.second.GetMean())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Grava a média e a meia-largura do intervalo de confiança de cada valor do resumo, uma linha por combinação.
+ * A coluna converged indica se a precisão foi alcançada ("-" sem --precision).
+ */
+bool WriteStatistics(const std::string &fileName, const std::vector<Replication> &replications, double precision,
+                     double confidence) {
+  std::vector<std::string> keys;
+  for (const auto& replication : replications) {
+    for (const auto& entry : replication.statistics) {
+      if (std::find(keys.begin(), keys.end(), entry.first) == keys.end()) {
+        keys.push_back(entry.first);
+      }
+    }
+  }
+
+  std::string text;
+  if (!replications.empty()) {
+    for (const auto& parameter : replications[0].job.parameters) {
+      AppendField(text, parameter.first);
+      text += ",";
+    }
+  }
+  text += "runs,converged";
+  for (const auto& key : keys) {
+    text += ",";
+    AppendField(text, key + "_mean");
+    text += ",";
+    AppendField(text, key + "_ci");
+  }
+  text += "\n";
+
+  char number[32];
+  for (const auto& replication : replications) {
+    for (const auto& parameter : replication.job.parameters) {
+      AppendField(text, parameter.second);
+      text += ",";
+    }
+    text += std::to_string(replication.completed) + "," + (precision <= 0 ? "-" : replication.converged ? "sim" : "nao");
+    for (const auto& key : keys) {
+      auto entry = std::find_if(replication.statistics.begin(), replication.statistics.end(),
+                                [&key](const auto& statistics) { return statistics.first == key; });
+      if (entry == replication.statistics.end()) {
+        text += ",,";
+        continue;
+      }
+      std::snprintf(number, sizeof(number), ",%.9g,%.9g", entry->second.GetMean(),
+                    entry->second.GetConfidenceHalfWidth(confidence));
+      text += number;
+    }
+    text += "\n";
+  }
+
+  std::ofstream file(fileName);
+  file.write(text.data(), text.size());
+  return static_cast<bool>(file);
+}
+
+/**
+ * Função principal.
+ */
+int main(int argc, char *argv[]) {
+  std::string program = "";
+  std::string topologies = "topologias/topologia1.txt";
+  std::string protocols = "rip,olsr";
+  std::string failures = "file";
+  uint32_t runs = 1;
+  uint32_t jobs = 0;
+  std::string workdir = "sweep";
+  std::string output = "sweep.csv";
+  std::string statistics = "sweep_stats.csv";
+  double precision = 0;
+  uint32_t minRuns = 3;
+  double confidence = 0.95;
+  std::string extra = "";
+
+  CommandLine cmd;
+  cmd.AddValue ("program", "Executável do cenário topologia", program);
+  cmd.AddValue ("topologies", "Topologias separadas por vírgula (arquivo ou <gerador>:<roteadores>)", topologies);
+  cmd.AddValue ("protocols", "Protocolos de roteamento separados por vírgula", protocols);
+  cmd.AddValue ("failures", "Cenários de falha separados por vírgula (file, none, <queda>:<retorno> ou arquivo de falhas)", failures);
+  cmd.AddValue ("runs", "Número de sementes (RngRun de 1 a runs), ou o máximo de sementes com --precision", runs);
+  cmd.AddValue ("precision", "Meia-largura do intervalo de confiança, relativa à média, que encerra as repetições (0 executa sempre --runs sementes)", precision);
+  cmd.AddValue ("minRuns", "Número mínimo de sementes com --precision (pelo menos 3)", minRuns);
+  cmd.AddValue ("confidence", "Nível de confiança dos intervalos", confidence);
+  cmd.AddValue ("jobs", "Número de processos simultâneos (0 usa todos os núcleos)", jobs);
+  cmd.AddValue ("workdir", "Pasta com os arquivos de cada execução", workdir);
+  cmd.AddValue ("output", "Tabela CSV com os resultados de todas as execuções", output);
+  cmd.AddValue ("statistics", "Tabela CSV com a média e o intervalo de confiança de cada combinação", statistics);
+  cmd.AddValue ("extra", "Argumentos adicionais do cenário, separados por espaço", extra);
+  cmd.Parse (argc, argv);
+
+  if (program.empty()) {
+    NS_LOG_ERROR("O executável do cenário (--program) é obrigatório.");
+    return 1;
+  }
+  if (jobs == 0) {
+    jobs = std::max (1u, std::thread::hardware_concurrency ());
+  }
+  if (precision < 0 || confidence <= 0 || confidence >= 1 || runs == 0) {
+    NS_LOG_ERROR("Parâmetros de repetição inválidos.");
+    return 1;
+  }
+  // Com duas sementes o intervalo é instável demais para encerrar as repetições
+  minRuns = std::min(std::max(3u, minRuns), runs);
+
+  std::vector<std::string> extraArguments = SplitList(extra, ' ');
+  bool captureOverridden = std::any_of(extraArguments.begin(), extraArguments.end(), [](const std::string &argument) {
+    return argument.compare(0, 16, "--captureFilter=") == 0;
+  });
+  SweepRunner runner (program, jobs);
+  std::vector<Replication> replications;
+
+  for (const auto& topology : SplitList(topologies, ',')) {
+    std::vector<std::string> topologyArguments;
+    size_t colon = topology.find(':');
+    if (colon == std::string::npos) {
+      topologyArguments.push_back("--topology=" + topology);
+    } else {
+      topologyArguments.push_back("--generator=" + topology.substr(0, colon));
+      topologyArguments.push_back("--routers=" + topology.substr(colon + 1));
+    }
+
+    for (const auto& protocol : SplitList(protocols, ',')) {
+      for (const auto& failure : SplitList(failures, ',')) {
+        std::vector<std::string> failureArguments;
+        if (failure == "none") {
+          failureArguments.push_back("--failureDown=0");
+        } else if (failure != "file") {
+          size_t separator = failure.find(':');
+          if (separator == std::string::npos) {
+            failureArguments.push_back("--failures=" + failure);
+          } else {
+            failureArguments.push_back("--failureDown=" + failure.substr(0, separator));
+            failureArguments.push_back("--failureUp=" + failure.substr(separator + 1));
+          }
+        }
+
+        Replication replication;
+        replication.job.parameters = {{"topology", topology}, {"protocol", protocol}, {"failure", failure}};
+        replication.job.arguments = topologyArguments;
+        replication.job.arguments.insert(replication.job.arguments.end(), failureArguments.begin(), failureArguments.end());
+        replication.job.arguments.push_back("--routingProtocol=" + protocol);
+        if (!captureOverridden) {
+          replication.job.arguments.push_back("--captureFilter=none");
+        }
+        replication.job.arguments.insert(replication.job.arguments.end(), extraArguments.begin(), extraArguments.end());
+        replications.push_back(replication);
+      }
+    }
+  }
+
+  // Cada execução é uma nova semente de uma combinação
+  std::vector<uint32_t> jobReplication;
+  auto addRun = [&](uint32_t index) {
+    Replication &replication = replications[index];
+    SweepJob job = replication.job;
+    job.parameters.emplace_back("run", std::to_string(replication.nextRun));
+    job.directory = workdir + "/" + std::to_string(runner.GetNJobs());
+    job.arguments.push_back("--RngRun=" + std::to_string(replication.nextRun));
+    job.arguments.push_back("--subfolder=" + job.directory);
+    ++replication.nextRun;
+    jobReplication.push_back(index);
+    runner.AddJob(job);
+  };
+
+  // Sem --precision, todas as sementes entram na fila de uma vez. Com --precision, cada combinação começa
+  // com minRuns sementes (ou mais, para ocupar todos os processos) e recebe uma nova semente a cada
+  // execução concluída, até alcançar a precisão ou o máximo de sementes.
+  uint32_t initialRuns = runs;
+  if (precision > 0) {
+    uint32_t share = (jobs + replications.size() - 1) / std::max<size_t>(1, replications.size());
+    initialRuns = std::min(runs, std::max(minRuns, share));
+  }
+  for (uint32_t index = 0; index < replications.size(); ++index) {
+    for (uint32_t run = 0; run < initialRuns; ++run) {
+      addRun(index);
+    }
+  }
+
+  runner.SetJobFinishedCallback([&](uint32_t job) {
+    Replication &replication = replications[jobReplication[job]];
+    if (runner.IsSuccessful(job)) {
+      ++replication.completed;
+      for (const auto& value : runner.GetSummary(job).GetValues()) {
+        auto entry = std::find_if(replication.statistics.begin(), replication.statistics.end(),
+                                  [&value](const auto& statistics) { return statistics.first == value.first; });
+        if (entry == replication.statistics.end()) {
+          replication.statistics.emplace_back(value.first, RunningStatistics());
+          entry = replication.statistics.end() - 1;
+        }
+        entry->second.Add(value.second);
+      }
+    }
+    if (precision <= 0 || replication.converged) {
+      return;
+    }
+    if (replication.completed >= minRuns && IsPrecise(replication, precision, confidence)) {
+      replication.converged = true;
+    } else if (replication.nextRun <= runs) {
+      addRun(jobReplication[job]);
+    }
+  });
+
+  std::cout << "Executando " << runner.GetNJobs() << " simulações em " << jobs << " processos";
+  if (precision > 0) {
+    std::cout << " (até " << runs << " sementes por combinação)";
+  }
+  std::cout << "..." << std::endl;
+  uint32_t failed = runner.Run();
+
+  if (!runner.WriteTable(output)) {
+    NS_LOG_ERROR("Não foi possível gravar a tabela de resultados.");
+    return 1;
+  }
+  std::cout << "Resultados em " << output << " (" << failed << " execuções com falha)" << std::endl;
+
+  if (!WriteStatistics(statistics, replications, precision, confidence)) {
+    NS_LOG_ERROR("Não foi possível gravar a tabela de estatísticas.");
+    return 1;
+  }
+  for (const auto& replication : replications) {
+    for (const auto& parameter : replication.job.parameters) {
+      std::cout << parameter.first << "=" << parameter.second << " ";
+    }
+    std::cout << replication.completed << " execuções";
+    if (precision > 0 && !replication.converged) {
+      std::cout << " (precisão não alcançada)";
+    }
+    std::cout << std::endl;
+  }
+  std::cout << "Médias e intervalos de confiança em " << statistics << std::endl;
+
+  return failed == 0 ? 0 : 1;
+}
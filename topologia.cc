@@ -0,0 +1,44 @@
+// Cenário genérico: a topologia (nós, enlaces, custos e falhas) é lida de um arquivo texto,
+// de forma que novas topologias podem ser simuladas sem recompilar. O formato do arquivo está
+// descrito em routing-sim/helper/topology-loader.h e a pasta topologias contém as topologias 1 a 3.
+//
+// A simulação é dividida em fases nos instantes de queda e retorno dos enlaces, e o tempo de
+// convergência dos roteadores é medido em cada fase.
+//
+// Também é possível gerar topologias sintéticas de N roteadores (grid, ring, waxman ou ba) com
+// --generator e --routers, para medir a convergência em redes grandes. Os custos RIP dos enlaces
+// são sorteados da distribuição passada em --linkCost (ex.: "ns3::UniformRandomVariable[Min=1|Max=5]").
+// ./waf --run "topologia --generator=waxman --routers=1000 --degree=4 --routingProtocol=olsr --subfolder=resultados"
+//
+// Para topologias grandes, a simulação pode ser distribuída entre vários processos com o simulador
+// distribuído do ns-3 (requer ./waf configure --enable-mpi). Os roteadores são divididos entre os
+// processos pelo TopologyPartitioner; T e R ficam no processo 0, que imprime os resultados, a divisão
+// e o lookahead (menor atraso entre os enlaces que ligam processos diferentes). Enlaces CSMA nunca são
+// divididos, e --minLookahead impede a divisão de enlaces ponto a ponto mais rápidos que o valor dado.
+// mpirun -np 4 ./waf --run "topologia --generator=waxman --routers=10000 --distributed --subfolder=resultados"
+//
+// As falhas da topologia podem ser substituídas por um arquivo com quedas de enlaces ou de nós,
+// flapping e falhas aleatórias (MTBF/MTTR), no formato de routing-sim/helper/topology-loader.h:
+// ./waf --run "topologia --generator=waxman --routers=1000 --failures=falhas.txt --RngRun=2 --subfolder=resultados"
+//
+// A animação do NetAnim só é gravada com --animation (ex.: --animation --animationStart=90 --animationStop=110),
+// e não é gravada na simulação distribuída.
+//
+// O código compartilhado pelos cenários está no módulo routing-sim, que deve ser copiado (ou ligado
+// com ln -s) para a pasta contrib do ns-3 antes de compilar: ./waf configure && ./waf build
+//
+// Para rodar a simulação com ambos os protocolos de roteamento, execute:
+// (Criar a pasta "resultados" antes de executar o comando)
+// ./waf --run "topologia --topology=topologias/topologia2.txt --routingProtocol=rip --subfolder=resultados" && ./waf --run "topologia --topology=topologias/topologia2.txt --routingProtocol=olsr --subfolder=resultados"
+
+#include "ns3/routing-sim-module.h"
+
+using namespace ns3;
+
+/**
+ * Função principal.
+ */
+int main(int argc, char *argv[]) {
+  // LogComponentEnable("TopologyScenario", LOG_LEVEL_INFO);
+  return RunTopologyScenario (argc, argv, "topologias/topologia1.txt");
+}